@@ -0,0 +1,152 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Batch benchmark: throughput of BatchTriangulator over many small polygons,
+// the kind of input of map tiles and glyph outlines, from one thread up to
+// the hardware threads. The inputs are fed in batches whose latency is
+// reported too, against triangulating them one CDT at a time.
+//
+// Usage: bench_batch [num_polygons] [max_threads]
+
+#include "bench_util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+namespace {
+
+const std::size_t kBatchSize = 1024;
+
+// Star shaped polygons of 8 to 200 points, every fourth with a hole
+std::vector<p2t::BatchInput> Polygons(std::size_t num_polygons,
+                                      std::vector<std::unique_ptr<p2t::Point>>& points)
+{
+  std::mt19937_64 rng(3);
+  std::uniform_int_distribution<int> size(8, 200);
+  std::uniform_real_distribution<double> radius(5, 10);
+  auto new_point = [&points](double x, double y) {
+    points.emplace_back(new p2t::Point(x, y));
+    return points.back().get();
+  };
+  std::vector<p2t::BatchInput> inputs(num_polygons);
+  for (std::size_t i = 0; i < num_polygons; ++i) {
+    const int n = size(rng);
+    for (int k = 0; k < n; ++k) {
+      const double angle = 2 * M_PI * k / n;
+      const double r = radius(rng);
+      inputs[i].polyline.push_back(new_point(r * std::cos(angle), r * std::sin(angle)));
+    }
+    if (i % 4 == 0) {
+      inputs[i].holes.push_back({ new_point(-1, -1), new_point(-1, 1), new_point(1, 1),
+                                  new_point(1, -1) });
+    }
+  }
+  return inputs;
+}
+
+double Percentile(std::vector<double> values, double p)
+{
+  std::sort(values.begin(), values.end());
+  return values[std::min(values.size() - 1, static_cast<std::size_t>(p * values.size()))];
+}
+
+void Report(const char* name, unsigned threads, std::size_t num_polygons, double total_ms,
+            const std::vector<double>& batch_ms)
+{
+  std::printf("%-12s %8u %14.0f %10.3f %10.3f %10.3f\n", name, threads,
+              static_cast<double>(num_polygons) / total_ms * 1e3, Percentile(batch_ms, 0.5),
+              Percentile(batch_ms, 0.99), Percentile(batch_ms, 1.0));
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::size_t num_polygons = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+  const unsigned max_threads = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10))
+                                        : std::max(1u, std::thread::hardware_concurrency());
+
+  std::printf("%-12s %8s %14s %10s %10s %10s\n", "mode", "threads", "polygons/s", "p50 ms",
+              "p99 ms", "max ms");
+
+  std::vector<unsigned> thread_counts;
+  for (unsigned threads = 1; threads < max_threads; threads *= 2) {
+    thread_counts.push_back(threads);
+  }
+  thread_counts.push_back(max_threads);
+
+  // Fresh points for every run, as triangulating adds edges to them
+  {
+    std::vector<std::unique_ptr<p2t::Point>> points;
+    const auto inputs = Polygons(num_polygons, points);
+    std::vector<double> batch_ms;
+    bench::Timer total;
+    for (std::size_t begin = 0; begin < inputs.size(); begin += kBatchSize) {
+      bench::Timer timer;
+      const std::size_t end = std::min(inputs.size(), begin + kBatchSize);
+      for (std::size_t i = begin; i < end; ++i) {
+        p2t::CDT cdt(inputs[i].polyline);
+        for (auto& hole : inputs[i].holes) {
+          cdt.AddHole(hole);
+        }
+        cdt.Triangulate();
+      }
+      batch_ms.push_back(timer.Elapsed());
+    }
+    Report("cdt", 1, num_polygons, total.Elapsed(), batch_ms);
+  }
+
+  for (unsigned threads : thread_counts) {
+    std::vector<std::unique_ptr<p2t::Point>> points;
+    auto inputs = Polygons(num_polygons, points);
+    std::vector<std::vector<p2t::BatchInput>> batches;
+    for (std::size_t begin = 0; begin < inputs.size(); begin += kBatchSize) {
+      const auto end = inputs.begin() + std::min(inputs.size(), begin + kBatchSize);
+      batches.emplace_back(std::make_move_iterator(inputs.begin() + begin),
+                           std::make_move_iterator(end));
+    }
+
+    p2t::BatchTriangulator batch(threads);
+    std::vector<p2t::BatchResult> results;
+    std::vector<double> batch_ms;
+    bench::Timer total;
+    for (const auto& inputs_batch : batches) {
+      bench::Timer timer;
+      batch.Triangulate(inputs_batch, results);
+      batch_ms.push_back(timer.Elapsed());
+    }
+    Report("batch", threads, num_polygons, total.Elapsed(), batch_ms);
+  }
+  return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Shared helpers for the benchmark executables. Every benchmark links
+// bench_alloc.cc, which replaces the global allocation functions so that heap
+// traffic can be counted.
+
+#pragma once
+
+#include <poly2tri/poly2tri.h>
+
+#include <input.h>
+#include <workloads.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/// Number of calls to the global operator new since program start
+std::atomic<std::uint64_t>& AllocationCount();
+
+class Timer {
+public:
+  Timer() : start_(std::chrono::steady_clock::now())
+  {
+  }
+
+  /// Elapsed time in milliseconds
+  double Elapsed() const
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_)
+        .count();
+  }
+
+private:
+  std::chrono::steady_clock::time_point start_;
+};
+
+/// A polygon with holes and Steiner points, owning its points
+struct Input {
+  std::vector<p2t::Point*> polyline;
+  std::vector<std::vector<p2t::Point*>> holes;
+  std::vector<p2t::Point*> steiner;
+
+  Input() = default;
+  Input(const Input&) = delete;
+  Input& operator=(const Input&) = delete;
+  Input(Input&&) = default;
+  Input& operator=(Input&&) = default;
+
+  ~Input()
+  {
+    for (auto p : polyline) {
+      delete p;
+    }
+    for (auto& hole : holes) {
+      for (auto p : hole) {
+        delete p;
+      }
+    }
+    for (auto p : steiner) {
+      delete p;
+    }
+  }
+
+  std::size_t size() const
+  {
+    std::size_t n = polyline.size() + steiner.size();
+    for (auto& hole : holes) {
+      n += hole.size();
+    }
+    return n;
+  }
+};
+
+/// A copy of a workload's polygon
+inline Input FromPolygon(const workload::Polygon& polygon)
+{
+  Input input;
+  for (const auto& p : polygon.outline) {
+    input.polyline.push_back(new p2t::Point(p.x, p.y));
+  }
+  for (const auto& hole : polygon.holes) {
+    input.holes.emplace_back();
+    for (const auto& p : hole) {
+      input.holes.back().push_back(new p2t::Point(p.x, p.y));
+    }
+  }
+  for (const auto& p : polygon.steiner) {
+    input.steiner.push_back(new p2t::Point(p.x, p.y));
+  }
+  return input;
+}
+
+/// Feed an input into a CDT
+template <class Kernel>
+void AddInput(p2t::BasicCDT<Kernel>& cdt, const Input& input)
+{
+  for (auto& hole : input.holes) {
+    cdt.AddHole(hole);
+  }
+  for (auto p : input.steiner) {
+    cdt.AddPoint(p);
+  }
+}
+
+/// Path of a file in testbed/data
+inline std::string DataFile(const std::string& name)
+{
+#ifdef P2T_BASE_DIR
+  return std::string(P2T_BASE_DIR) + "/testbed/data/" + name;
+#else
+  return "testbed/data/" + name;
+#endif
+}
+
+} // namespace bench
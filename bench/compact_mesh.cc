@@ -0,0 +1,187 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Compact mesh benchmark: the memory of a triangulation held as Triangles
+// against the corner table of CompactMesh, and the time of the walks that
+// MeshClean and Legalize make over it in each: a flood fill across edges
+// that are not constrained, and an incircle test across every edge.
+//
+// Usage: bench_compact_mesh [num_points]
+
+#include "bench_util.h"
+
+#include <cstdio>
+
+namespace {
+
+struct Walks {
+  std::size_t reached = 0;
+  std::size_t not_delaunay = 0;
+};
+
+Walks WalkTriangles(const std::vector<p2t::Triangle*>& triangles, std::vector<char>& visited,
+                    std::vector<p2t::Triangle*>& stack, double& flood_ms, double& incircle_ms)
+{
+  Walks walks;
+  bench::Timer flood;
+  visited.assign(triangles.size(), 0);
+  stack.assign(1, triangles[0]);
+  while (!stack.empty()) {
+    p2t::Triangle* t = stack.back();
+    stack.pop_back();
+    if (visited[t->InteriorIndex()]) {
+      continue;
+    }
+    visited[t->InteriorIndex()] = 1;
+    ++walks.reached;
+    for (int i = 0; i < 3; ++i) {
+      if (!t->constrained_edge[i]) {
+        stack.push_back(t->GetNeighbor(i));
+      }
+    }
+  }
+  flood_ms = flood.Elapsed();
+
+  bench::Timer incircle;
+  for (p2t::Triangle* t : triangles) {
+    for (int i = 0; i < 3; ++i) {
+      p2t::Triangle* ot = t->GetNeighbor(i);
+      if (ot && ot->IsInterior()) {
+        const p2t::Point& op = *ot->OppositePoint(*t, *t->GetPoint(i));
+        walks.not_delaunay +=
+            p2t::Incircle(*t->GetPoint(0), *t->GetPoint(1), *t->GetPoint(2), op);
+      }
+    }
+  }
+  incircle_ms = incircle.Elapsed();
+  return walks;
+}
+
+Walks WalkMesh(const p2t::CompactMesh& mesh, const std::vector<p2t::Point>& points,
+               std::vector<char>& visited, std::vector<std::uint32_t>& stack, double& flood_ms,
+               double& incircle_ms)
+{
+  using p2t::CompactMesh;
+  Walks walks;
+  bench::Timer flood;
+  visited.assign(mesh.size(), 0);
+  stack.assign(1, 0);
+  while (!stack.empty()) {
+    const std::uint32_t t = stack.back();
+    stack.pop_back();
+    if (visited[t]) {
+      continue;
+    }
+    visited[t] = 1;
+    ++walks.reached;
+    for (std::uint32_t c = 3 * t; c < 3 * t + 3; ++c) {
+      if (!mesh.IsConstrained(c)) {
+        stack.push_back(CompactMesh::TriangleOf(mesh.Opposite(c)));
+      }
+    }
+  }
+  flood_ms = flood.Elapsed();
+
+  bench::Timer incircle;
+  for (std::uint32_t c = 0; c < 3 * mesh.size(); ++c) {
+    const std::uint32_t o = mesh.Opposite(c);
+    if (o != p2t::kNoCorner) {
+      const std::uint32_t a = c - c % 3;
+      walks.not_delaunay += p2t::Incircle(points[mesh.Vertex(a)], points[mesh.Vertex(a + 1)],
+                                          points[mesh.Vertex(a + 2)], points[mesh.Vertex(o)]);
+    }
+  }
+  incircle_ms = incircle.Elapsed();
+  return walks;
+}
+
+void Report(const char* name, double bytes, std::size_t num_triangles, double flood_ms,
+            double incircle_ms)
+{
+  std::printf("%-12s %10.1f %14.1f %12.1f %16.1f %14.1f\n", name, bytes / (1 << 20),
+              bytes / num_triangles, flood_ms, incircle_ms,
+              1e-3 * num_triangles / (flood_ms + incircle_ms));
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  // About two triangles per point
+  const std::size_t num_points = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+  const bench::Input input = bench::FromPolygon(workload::Uniform(num_points, 42));
+  p2t::CDT cdt(input.polyline);
+  bench::AddInput(cdt, input);
+  bench::Timer triangulate;
+  cdt.Triangulate();
+  const double triangulate_ms = triangulate.Elapsed();
+
+  const std::vector<p2t::Triangle*>& triangles = cdt.GetTriangles();
+  p2t::CompactMesh mesh;
+  bench::Timer exported;
+  cdt.ExportMesh(mesh);
+  const double export_ms = exported.Elapsed();
+  std::printf("%zu triangles, triangulate %.1f ms, ExportMesh %.1f ms\n\n", triangles.size(),
+              triangulate_ms, export_ms);
+
+  // The mesh is walked with the points in an array, as index buffers are used
+  std::vector<p2t::Point> points;
+  points.reserve(input.size());
+  for (auto input_points : { &input.polyline, &input.steiner }) {
+    for (auto p : *input_points) {
+      points.emplace_back(p->x, p->y);
+    }
+  }
+  std::vector<char> visited;
+  std::printf("%-12s %10s %14s %12s %16s %14s\n", "mesh", "MiB", "bytes/triangle",
+              "flood fill ms", "incircle all ms", "Mtriangles/s");
+
+  // The map holds the triangles outside the polygon as well
+  double flood_ms, incircle_ms;
+  std::vector<p2t::Triangle*> triangle_stack;
+  const Walks expected = WalkTriangles(triangles, visited, triangle_stack, flood_ms, incircle_ms);
+  const double triangle_bytes = static_cast<double>(cdt.GetMap().size() * sizeof(p2t::Triangle) +
+                                                    triangles.size() * sizeof(p2t::Triangle*));
+  Report("Triangle", triangle_bytes, triangles.size(), flood_ms, incircle_ms);
+
+  std::vector<std::uint32_t> corner_stack;
+  const Walks walks = WalkMesh(mesh, points, visited, corner_stack, flood_ms, incircle_ms);
+  const double mesh_bytes =
+      static_cast<double>(mesh.vertices().size() * sizeof(std::uint32_t) +
+                          mesh.opposites().size() * sizeof(std::uint32_t) +
+                          mesh.constrained().size() * sizeof(std::uint8_t));
+  Report("CompactMesh", mesh_bytes, mesh.size(), flood_ms, incircle_ms);
+
+  if (walks.reached != expected.reached || walks.not_delaunay != expected.not_delaunay) {
+    std::printf("MISMATCH\n");
+  }
+  return 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Coordinate buffer benchmark: polygons arriving as flat coordinate arrays,
+// triangulated through heap allocated Points and mapped back to indices with
+// a hash map, against feeding the arrays to the CDT directly and reading the
+// triangle indices off it. Reports time and heap allocations per polygon.
+//
+// Usage: bench_coordinate_input [num_polygons]
+
+#include "bench_util.h"
+
+#include <cmath>
+#include <cstdio>
+#include <unordered_map>
+
+namespace {
+
+struct Polygon {
+  std::vector<double> coords;
+  std::vector<std::size_t> hole_offsets;
+  std::size_t steiner_begin;
+
+  std::size_t num_points() const { return coords.size() / 2; }
+};
+
+// Star shaped polygons of 50 to 500 points with a square hole and a few
+// Steiner points
+std::vector<Polygon> Polygons(std::size_t num_polygons)
+{
+  std::mt19937_64 rng(9);
+  std::uniform_int_distribution<int> size(50, 500);
+  std::uniform_real_distribution<double> radius(5, 10);
+  std::vector<Polygon> polygons(num_polygons);
+  for (auto& polygon : polygons) {
+    const int n = size(rng);
+    for (int i = 0; i < n; ++i) {
+      const double angle = 2 * M_PI * i / n;
+      const double r = radius(rng);
+      polygon.coords.insert(polygon.coords.end(), { r * std::cos(angle), r * std::sin(angle) });
+    }
+    polygon.hole_offsets.push_back(polygon.num_points());
+    polygon.coords.insert(polygon.coords.end(), { -1, -1, 1, -1, 1, 1, -1, 1 });
+    polygon.steiner_begin = polygon.num_points();
+    polygon.coords.insert(polygon.coords.end(), { 3, 0.5, -2.5, 2, 0.5, -3 });
+  }
+  return polygons;
+}
+
+std::size_t ViaPoints(const Polygon& polygon, std::vector<std::size_t>& indices)
+{
+  std::vector<p2t::Point*> points;
+  for (std::size_t i = 0; i < polygon.num_points(); ++i) {
+    points.push_back(new p2t::Point(polygon.coords[2 * i], polygon.coords[2 * i + 1]));
+  }
+  std::unordered_map<const p2t::Point*, std::size_t> index;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    index[points[i]] = i;
+  }
+
+  const auto hole = points.begin() + static_cast<std::ptrdiff_t>(polygon.hole_offsets[0]);
+  const auto steiner = points.begin() + static_cast<std::ptrdiff_t>(polygon.steiner_begin);
+  p2t::CDT cdt(std::vector<p2t::Point*>(points.begin(), hole));
+  cdt.AddHole(std::vector<p2t::Point*>(hole, steiner));
+  for (auto p = steiner; p != points.end(); ++p) {
+    cdt.AddPoint(*p);
+  }
+  cdt.Triangulate();
+
+  indices.clear();
+  for (auto t : cdt.GetTriangles()) {
+    for (int i = 0; i < 3; ++i) {
+      indices.push_back(index[t->GetPoint(i)]);
+    }
+  }
+  for (auto p : points) {
+    delete p;
+  }
+  return indices.size() / 3;
+}
+
+template <class Triangulate>
+void Run(const char* name, const std::vector<Polygon>& polygons, Triangulate triangulate)
+{
+  std::vector<std::size_t> indices;
+  std::size_t triangles = 0;
+  const std::uint64_t allocations = bench::AllocationCount();
+  bench::Timer timer;
+  for (const auto& polygon : polygons) {
+    triangles += triangulate(polygon, indices);
+  }
+  const double n = static_cast<double>(polygons.size());
+  std::printf("%-24s %12.2f %16.2f %12zu\n", name, timer.Elapsed() * 1e3 / n,
+              static_cast<double>(bench::AllocationCount() - allocations) / n, triangles);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::size_t num_polygons = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+  const auto polygons = Polygons(num_polygons);
+
+  std::printf("%-24s %12s %16s %12s\n", "input", "us/polygon", "allocs/polygon", "triangles");
+  Run("points + hash map", polygons, ViaPoints);
+
+  p2t::CDT cdt(p2t::CoordinateBuffer<double>{ polygons[0].coords.data(), polygons[0].num_points(),
+                                              polygons[0].hole_offsets.data(), 1,
+                                              polygons[0].steiner_begin });
+  Run("coordinate buffer", polygons,
+      [&cdt](const Polygon& polygon, std::vector<std::size_t>& indices) {
+        cdt.Reset(p2t::CoordinateBuffer<double>{ polygon.coords.data(), polygon.num_points(),
+                                                 polygon.hole_offsets.data(), 1,
+                                                 polygon.steiner_begin });
+        cdt.Triangulate();
+        cdt.GetTriangleIndices(indices);
+        return indices.size() / 3;
+      });
+  return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Constraint insertion benchmark: a sliver hole whose long edges run through a
+// band of Steiner points, so that inserting each of them flips and scans
+// through about as many triangles as there are points.
+//
+// Usage: bench_edge_event [num_points...]
+
+#include "bench_util.h"
+
+#include <cstdio>
+#include <exception>
+
+namespace {
+
+// Slightly tilted so that the edges are not horizontal
+double Line(double x)
+{
+  return 0.5 + 1e-3 * (x - 0.5);
+}
+
+bench::Input Sliver(std::size_t num_points)
+{
+  bench::Input input;
+  input.polyline = { new p2t::Point(0, 0), new p2t::Point(1, 0), new p2t::Point(1, 1),
+                     new p2t::Point(0, 1) };
+  input.holes.push_back({ new p2t::Point(0.001, Line(0.001)), new p2t::Point(0.999, Line(0.999)),
+                          new p2t::Point(0.999, Line(0.999) + 1e-7) });
+
+  // Points alternate above and below the sliver, all under its top corners
+  std::mt19937_64 rng(19);
+  std::uniform_real_distribution<double> x(0.002, 0.99);
+  std::uniform_real_distribution<double> offset(1e-6, 1e-5);
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const double px = x(rng);
+    const double py = i % 2 == 0 ? Line(px) + 1e-7 + offset(rng) : Line(px) - offset(rng);
+    input.steiner.push_back(new p2t::Point(px, py));
+  }
+  return input;
+}
+
+void Triangulate(const bench::Input& input)
+{
+  bench::Timer timer;
+  try {
+    p2t::CDT cdt(input.polyline);
+    bench::AddInput(cdt, input);
+    cdt.Triangulate();
+    std::printf("%10zu %10zu %12zu %10.3f\n", input.size(), cdt.GetTriangles().size(),
+                cdt.GetFlipCount(), timer.Elapsed());
+  } catch (std::exception& e) {
+    std::printf("%10zu failed: %s\n", input.size(), e.what());
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  std::printf("%10s %10s %12s %10s\n", "points", "triangles", "flips", "ms");
+  if (argc > 1) {
+    for (int i = 1; i < argc; ++i) {
+      Triangulate(Sliver(std::strtoull(argv[i], nullptr, 10)));
+    }
+  } else {
+    for (std::size_t n = 1000; n <= 200000; n *= 10) {
+      Triangulate(Sliver(n));
+    }
+    Triangulate(Sliver(200000));
+  }
+  return 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Export benchmark: turning a triangulation into index and neighbor buffers.
+// The consumer side way maps Point and Triangle pointers to indices with hash
+// maps; ExportTriangles writes the buffers directly, from Point pointer input
+// and from coordinate buffer input. Times are against the triangulation.
+//
+// Usage: bench_export [num_points]
+
+#include "bench_util.h"
+
+#include <cstdio>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+
+struct Buffers {
+  std::vector<std::uint32_t> triangles;
+  std::vector<std::uint32_t> neighbors;
+  std::vector<std::uint8_t> constrained;
+
+  void Resize(std::size_t num_triangles)
+  {
+    triangles.resize(3 * num_triangles);
+    neighbors.resize(3 * num_triangles);
+    constrained.resize(num_triangles);
+  }
+};
+
+void HashMaps(p2t::CDT& cdt, const bench::Input& input, Buffers& buffers)
+{
+  std::unordered_map<const p2t::Point*, std::uint32_t> point_index;
+  for (auto p : input.polyline) {
+    point_index.emplace(p, static_cast<std::uint32_t>(point_index.size()));
+  }
+  for (auto p : input.steiner) {
+    point_index.emplace(p, static_cast<std::uint32_t>(point_index.size()));
+  }
+  const auto& triangles = cdt.GetTriangles();
+  std::unordered_map<const p2t::Triangle*, std::uint32_t> triangle_index;
+  for (std::size_t k = 0; k < triangles.size(); ++k) {
+    triangle_index.emplace(triangles[k], static_cast<std::uint32_t>(k));
+  }
+  buffers.Resize(triangles.size());
+  for (std::size_t k = 0; k < triangles.size(); ++k) {
+    std::uint8_t mask = 0;
+    for (int i = 0; i < 3; ++i) {
+      buffers.triangles[3 * k + i] = point_index[triangles[k]->GetPoint(i)];
+      const auto neighbor = triangle_index.find(triangles[k]->GetNeighbor(i));
+      buffers.neighbors[3 * k + i] = neighbor == triangle_index.end()
+                                       ? std::numeric_limits<std::uint32_t>::max()
+                                       : neighbor->second;
+      mask |= static_cast<std::uint8_t>(triangles[k]->constrained_edge[i] << i);
+    }
+    buffers.constrained[k] = mask;
+  }
+}
+
+void Export(p2t::CDT& cdt, Buffers& buffers)
+{
+  buffers.Resize(cdt.GetTriangles().size());
+  cdt.ExportTriangles(buffers.triangles.data(), buffers.neighbors.data(),
+                      buffers.constrained.data());
+}
+
+void Report(const char* name, double triangulate_ms, double export_ms)
+{
+  std::printf("%-28s %14.3f %12.3f %10.1f%%\n", name, triangulate_ms, export_ms,
+              100.0 * export_ms / triangulate_ms);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::size_t num_points = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::printf("%-28s %14s %12s %11s\n", "export", "triangulate ms", "export ms", "of total");
+
+  Buffers expected, buffers;
+  {
+    const bench::Input input = bench::FromPolygon(workload::Uniform(num_points, 42));
+    p2t::CDT cdt(input.polyline);
+    bench::AddInput(cdt, input);
+    bench::Timer triangulate;
+    cdt.Triangulate();
+    const double triangulate_ms = triangulate.Elapsed();
+
+    bench::Timer hash_maps;
+    HashMaps(cdt, input, expected);
+    Report("hash maps", triangulate_ms, hash_maps.Elapsed());
+
+    bench::Timer exported;
+    Export(cdt, buffers);
+    Report("ExportTriangles, pointers", triangulate_ms, exported.Elapsed());
+    if (buffers.triangles != expected.triangles || buffers.neighbors != expected.neighbors ||
+        buffers.constrained != expected.constrained) {
+      std::printf("MISMATCH\n");
+    }
+  }
+
+  {
+    const bench::Input input = bench::FromPolygon(workload::Uniform(num_points, 42));
+    std::vector<double> coords;
+    for (auto points : { &input.polyline, &input.steiner }) {
+      for (auto p : *points) {
+        coords.insert(coords.end(), { p->x, p->y });
+      }
+    }
+    p2t::CDT cdt(p2t::CoordinateBuffer<double>{ coords.data(), coords.size() / 2, nullptr, 0, 4 });
+    bench::Timer triangulate;
+    cdt.Triangulate();
+    const double triangulate_ms = triangulate.Elapsed();
+
+    bench::Timer exported;
+    Export(cdt, buffers);
+    Report("ExportTriangles, coordinates", triangulate_ms, exported.Elapsed());
+    if (buffers.triangles != expected.triangles) {
+      std::printf("MISMATCH\n");
+    }
+  }
+  return 0;
+}
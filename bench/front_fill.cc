@@ -0,0 +1,134 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Front filling benchmark: the angle decisions of the front filling
+// heuristics taken from the signs of cross and dot products, against the
+// atan2 they used to be computed with, and the triangulation time of inputs
+// that fill a lot of holes and basins.
+//
+// Usage: bench_front_fill [num_points]
+
+#include "bench_util.h"
+
+#include <poly2tri/common/utils.h>
+
+#include <cmath>
+#include <cstdio>
+#include <exception>
+
+namespace {
+
+void CompareDecisions(std::size_t n)
+{
+  std::mt19937_64 rng(31);
+  std::uniform_real_distribution<double> coord(-1.0, 1.0);
+  std::vector<p2t::Point> points;
+  points.reserve(3 * n);
+  for (std::size_t i = 0; i < 3 * n; ++i) {
+    points.emplace_back(coord(rng), coord(rng));
+  }
+
+  std::size_t atan2_count = 0;
+  bench::Timer atan2_timer;
+  for (std::size_t i = 0; i < n; ++i) {
+    double cross, dot;
+    p2t::AngleCrossDot(points[3 * i], points[3 * i + 1], points[3 * i + 2], cross, dot);
+    const double angle = std::atan2(cross, dot);
+    atan2_count += (angle > p2t::PI_div2 || angle < 0) + (angle < 0);
+    const double ax = points[3 * i].x - points[3 * i + 2].x;
+    const double ay = points[3 * i].y - points[3 * i + 2].y;
+    atan2_count += std::atan2(ay, ax) < p2t::PI_3div4;
+  }
+  const double atan2_ns = atan2_timer.Elapsed() * 1e6 / static_cast<double>(n);
+
+  std::size_t sign_count = 0;
+  bench::Timer sign_timer;
+  for (std::size_t i = 0; i < n; ++i) {
+    double cross, dot;
+    p2t::AngleCrossDot(points[3 * i], points[3 * i + 1], points[3 * i + 2], cross, dot);
+    sign_count += (p2t::AngleIsNegative(cross, dot) || p2t::AngleExceeds90Degrees(cross, dot))
+                  + p2t::AngleIsNegative(cross, dot);
+    const double ax = points[3 * i].x - points[3 * i + 2].x;
+    const double ay = points[3 * i].y - points[3 * i + 2].y;
+    sign_count += !p2t::DirectionExceeds135Degrees(ax, ay);
+  }
+  const double sign_ns = sign_timer.Elapsed() * 1e6 / static_cast<double>(n);
+
+  std::printf("%-24s %12s %12s\n", "decisions", "atan2 ns", "sign ns");
+  std::printf("%-24s %12.2f %12.2f %8s\n", "random triples", atan2_ns, sign_ns,
+              atan2_count == sign_count ? "" : "MISMATCH");
+}
+
+// Steiner points on a sine wave, which leaves a basin behind every trough
+bench::Input Wave(std::size_t num_points)
+{
+  bench::Input input;
+  input.polyline = { new p2t::Point(-1, -2), new p2t::Point(1, -2), new p2t::Point(1, 2),
+                     new p2t::Point(-1, 2) };
+  for (std::size_t i = 1; i <= num_points; ++i) {
+    const double x = -0.99 + 1.98 * static_cast<double>(i) / static_cast<double>(num_points + 1);
+    input.steiner.push_back(new p2t::Point(x, std::sin(x * 200.0)));
+  }
+  return input;
+}
+
+void Triangulate(const char* name, const bench::Input& input)
+{
+  bench::Timer timer;
+  try {
+    p2t::CDT cdt(input.polyline);
+    bench::AddInput(cdt, input);
+    cdt.Triangulate();
+    std::printf("%-24s %10zu %10.3f\n", name, input.size(), timer.Elapsed());
+  } catch (std::exception& e) {
+    std::printf("%-24s failed: %s\n", name, e.what());
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::size_t num_points = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+  CompareDecisions(num_points * 5);
+
+  std::printf("\n%-24s %10s %10s\n", "input", "points", "ms");
+  Triangulate("random square", bench::FromPolygon(workload::Uniform(num_points, 42)));
+  Triangulate("wave", Wave(num_points));
+  for (const char* file : { "dude.dat", "nazca_monkey.dat", "kzer-za.dat", "strange.dat" }) {
+    bench::Input input;
+    if (ParseFile(bench::DataFile(file), input.polyline, input.holes, input.steiner)) {
+      Triangulate(file, input);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Advancing front search benchmark.
+//
+// The first table compares locating random x positions on a front of n nodes
+// with the search tree against the walk from the last search position that
+// AdvancingFront used before it had an index, to show where the crossover is.
+// It also times LocatePoint, which legalization calls for points anywhere on
+// the front, against locating the same point through the tree by its x.
+// The second part triangulates inputs whose front grows to O(n) nodes.
+//
+// Usage: bench_front_search [num_points]
+
+#include "bench_util.h"
+
+#include <cstdio>
+#include <exception>
+
+namespace {
+
+// Advancing front lookup as it was done before the search tree
+p2t::Node* WalkLocateNode(p2t::Node*& search, double x)
+{
+  p2t::Node* node = search;
+  if (x < node->value) {
+    while ((node = node->prev) != nullptr) {
+      if (x >= node->value) {
+        return search = node;
+      }
+    }
+  } else {
+    while ((node = node->next) != nullptr) {
+      if (x < node->value) {
+        return search = node->prev;
+      }
+    }
+  }
+  return nullptr;
+}
+
+void CompareLookups(std::size_t n, std::size_t queries)
+{
+  std::vector<p2t::Point> points;
+  points.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    points.emplace_back(static_cast<double>(i), 0.0);
+  }
+  std::vector<p2t::Node> nodes(points.begin(), points.end());
+  p2t::AdvancingFront front(nodes.front(), nodes.back());
+  for (std::size_t i = 1; i + 1 < n; ++i) {
+    front.InsertAfter(nodes[i - 1], nodes[i]);
+  }
+
+  std::mt19937_64 rng(7);
+  std::uniform_real_distribution<double> coord(0.0, static_cast<double>(n - 1));
+  std::vector<double> xs(queries);
+  for (auto& x : xs) {
+    x = coord(rng);
+  }
+  std::vector<const p2t::Point*> ps(queries);
+  for (auto& p : ps) {
+    p = &points[rng() % n];
+  }
+
+  double checksum = 0;
+  bench::Timer tree_timer;
+  for (auto x : xs) {
+    checksum += front.LocateNode(x)->value;
+  }
+  const double tree_ns = tree_timer.Elapsed() * 1e6 / static_cast<double>(queries);
+
+  p2t::Node* search = &nodes.front();
+  bench::Timer walk_timer;
+  for (auto x : xs) {
+    checksum -= WalkLocateNode(search, x)->value;
+  }
+  const double walk_ns = walk_timer.Elapsed() * 1e6 / static_cast<double>(queries);
+
+  bench::Timer table_timer;
+  for (auto p : ps) {
+    checksum += front.LocatePoint(p)->value;
+  }
+  const double table_ns = table_timer.Elapsed() * 1e6 / static_cast<double>(queries);
+
+  bench::Timer by_x_timer;
+  for (auto p : ps) {
+    p2t::Node* node = front.LocateNode(p->x);
+    while (node->point != p) {
+      node = node->prev;
+    }
+    checksum -= node->value;
+  }
+  const double by_x_ns = by_x_timer.Elapsed() * 1e6 / static_cast<double>(queries);
+
+  std::printf("%10zu %12.1f %12.1f %12.1f %12.1f %8s\n", n, tree_ns, walk_ns, table_ns, by_x_ns,
+              checksum == 0 ? "" : "MISMATCH");
+}
+
+// Uniform Steiner points in a box much wider than it is tall
+bench::Input WideCloud(std::size_t num_points)
+{
+  bench::Input input;
+  const double width = 1000.0;
+  input.polyline = { new p2t::Point(0, 0), new p2t::Point(width, 0), new p2t::Point(width, 1),
+                     new p2t::Point(0, 1) };
+  workload::Rng rng(11);
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const double px = rng.Uniform(1e-3, width - 1e-3);
+    const double py = rng.Uniform(1e-3, 1.0 - 1e-3);
+    input.steiner.push_back(new p2t::Point(px, py));
+  }
+  return input;
+}
+
+void Triangulate(const char* name, const bench::Input& input)
+{
+  bench::Timer timer;
+  try {
+    p2t::CDT cdt(input.polyline);
+    bench::AddInput(cdt, input);
+    cdt.Triangulate();
+    std::printf("%-24s %10zu %10zu %10.3f\n", name, input.size(), cdt.GetTriangles().size(),
+                timer.Elapsed());
+  } catch (std::exception& e) {
+    std::printf("%-24s failed: %s\n", name, e.what());
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::size_t num_points = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+  std::printf("%10s %12s %12s %12s %12s\n", "front", "tree ns", "walk ns", "point ns",
+              "point/x ns");
+  for (std::size_t n = 4; n <= (1u << 16); n *= 2) {
+    CompareLookups(n, 200000);
+  }
+
+  std::printf("\n%-24s %10s %10s %10s\n", "input", "points", "triangles", "ms");
+  Triangulate("wide cloud", WideCloud(num_points));
+  Triangulate("comb", bench::FromPolygon(workload::Comb(num_points, 13)));
+  Triangulate("random square", bench::FromPolygon(workload::Uniform(num_points, 42)));
+  return 0;
+}
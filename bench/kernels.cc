@@ -0,0 +1,133 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Predicate kernel benchmark: the same inputs triangulated with each kernel
+// built into the library, side by side in one binary.
+//
+// Usage: bench_kernels [num_points]
+
+#include "bench_util.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+
+namespace {
+
+// Square with distinct Steiner points on an integer grid of the given size
+bench::Input IntegerSquare(std::size_t num_points, int size)
+{
+  bench::Input input;
+  input.polyline = { new p2t::Point(0, 0), new p2t::Point(size, 0), new p2t::Point(size, size),
+                     new p2t::Point(0, size) };
+  std::mt19937_64 rng(29);
+  std::uniform_int_distribution<int> coord(1, size - 1);
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const double x = coord(rng);
+    const double y = coord(rng);
+    input.steiner.push_back(new p2t::Point(x, y));
+  }
+  std::sort(input.steiner.begin(), input.steiner.end(), [](p2t::Point* a, p2t::Point* b) {
+    return a->x < b->x || (a->x == b->x && a->y < b->y);
+  });
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < input.steiner.size(); ++i) {
+    if (kept > 0 && *input.steiner[i] == *input.steiner[kept - 1]) {
+      delete input.steiner[i];
+    } else {
+      input.steiner[kept++] = input.steiner[i];
+    }
+  }
+  input.steiner.resize(kept);
+  return input;
+}
+
+template <class Kernel>
+void Triangulate(const char* input_name, const char* kernel_name, const bench::Input& input)
+{
+  bench::Timer timer;
+  try {
+    p2t::BasicCDT<Kernel> cdt(input.polyline);
+    bench::AddInput(cdt, input);
+    cdt.Triangulate();
+    std::printf("%-16s %-16s %10zu %10zu %10.3f\n", input_name, kernel_name, input.size(),
+                cdt.GetTriangles().size(), timer.Elapsed());
+  } catch (std::exception& e) {
+    std::printf("%-16s %-16s failed: %s\n", input_name, kernel_name, e.what());
+  }
+}
+
+// Points are shared between runs, so each run gets a fresh copy of the input
+template <class Kernel>
+void Run(const char* input_name, const char* kernel_name, bench::Input (*make)(std::size_t),
+         std::size_t num_points)
+{
+  Triangulate<Kernel>(input_name, kernel_name, make(num_points));
+}
+
+bench::Input Random(std::size_t num_points)
+{
+  return bench::FromPolygon(workload::Uniform(num_points, 42));
+}
+
+bench::Input Integer(std::size_t num_points)
+{
+  return IntegerSquare(num_points, 1 << 20);
+}
+
+// Small grid, so that many points are cocircular
+bench::Input Grid(std::size_t num_points)
+{
+  return IntegerSquare(num_points, 1 << 10);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::size_t num_points = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+  std::printf("%-16s %-16s %10s %10s %10s\n", "input", "kernel", "points", "triangles", "ms");
+  Run<p2t::InexactKernel>("random", "inexact", Random, num_points);
+#ifdef POLY2TRI_USE_EXACT
+  Run<p2t::FilteredExactKernel>("random", "filtered exact", Random, num_points);
+#endif
+  for (auto input : { std::make_pair("integer", Integer), std::make_pair("dense grid", Grid) }) {
+    Run<p2t::InexactKernel>(input.first, "inexact", input.second, num_points);
+#ifdef POLY2TRI_USE_EXACT
+    Run<p2t::FilteredExactKernel>(input.first, "filtered exact", input.second, num_points);
+#endif
+#ifdef __SIZEOF_INT128__
+    Run<p2t::IntegerExactKernel>(input.first, "integer exact", input.second, num_points);
+#endif
+  }
+  return 0;
+}
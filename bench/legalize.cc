@@ -0,0 +1,88 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Legalization benchmark: wall time and flip counts on inputs that cause long
+// cascades of flips, such as tight clusters of Steiner points and points on a
+// convex curve.
+//
+// Usage: bench_legalize [num_points]
+
+#include "bench_util.h"
+
+#include <cmath>
+#include <cstdio>
+#include <exception>
+
+namespace {
+
+// Steiner points on the parabola y = x^2, above a box that contains them
+bench::Input Parabola(std::size_t num_points)
+{
+  bench::Input input;
+  input.polyline = { new p2t::Point(-1, -1), new p2t::Point(1, -1), new p2t::Point(1, 2),
+                     new p2t::Point(-1, 2) };
+  for (std::size_t i = 1; i <= num_points; ++i) {
+    const double x = -0.99 + 1.98 * static_cast<double>(i) / static_cast<double>(num_points + 1);
+    input.steiner.push_back(new p2t::Point(x, x * x));
+  }
+  return input;
+}
+
+void Triangulate(const char* name, const bench::Input& input)
+{
+  bench::Timer timer;
+  try {
+    p2t::CDT cdt(input.polyline);
+    bench::AddInput(cdt, input);
+    cdt.Triangulate();
+    const double ms = timer.Elapsed();
+    const std::size_t flips = cdt.GetFlipCount();
+    std::printf("%-24s %10zu %12zu %10.2f %10.3f\n", name, input.size(), flips,
+                static_cast<double>(flips) / static_cast<double>(input.size()), ms);
+  } catch (std::exception& e) {
+    std::printf("%-24s failed: %s\n", name, e.what());
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::size_t num_points = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+  std::printf("%-24s %10s %12s %10s %10s\n", "input", "points", "flips", "per point", "ms");
+  Triangulate("random square", bench::FromPolygon(workload::Uniform(num_points, 42)));
+  Triangulate("clusters", bench::FromPolygon(workload::Clusters(num_points, 17, 16, 1e-3)));
+  Triangulate("single cluster", bench::FromPolygon(workload::Clusters(num_points, 17, 1, 1e-3)));
+  // The front filling is quadratic on this one, keep it small
+  Triangulate("parabola", Parabola(num_points / 20));
+  return 0;
+}
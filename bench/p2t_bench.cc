@@ -0,0 +1,476 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Headless benchmark driver: triangulates testbed .dat files and random point
+// distributions, read and generated as the testbed does, without opening a
+// window. Each input is triangulated the given number of times after some
+// warm-up runs, and each run is reported with the wall time of its phases,
+// its triangles per second and the peak resident set size of the process,
+// followed by the median of the runs, as CSV or as JSON. In builds with
+// POLY2TRI_STATS the counters and phase timers of CDT::GetStats follow.
+// With --trace the phases of the measured runs are also written to a file
+// of Chrome trace events, which chrome://tracing and Perfetto open.
+//
+// Usage: p2t_bench [--repeat N] [--warmup N] [--format csv|json] [--seed N]
+//                  [--trace FILE] <input>...
+//   where each input is a .dat file, random <num_points> <box_radius>, or
+//   <workload> <num_points> with a workload of testbed/workloads.h
+
+#include "bench_util.h"
+
+#include <input.h>
+#include <workloads.h>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Peak resident set size of the process in KiB, 0 where unknown
+std::uint64_t PeakRss()
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return counters.PeakWorkingSetSize / 1024;
+  }
+  return 0;
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return static_cast<std::uint64_t>(usage.ru_maxrss) / 1024;
+#else
+  return static_cast<std::uint64_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+struct Options {
+  int repeat = 5;
+  int warmup = 1;
+  bool json = false;
+  unsigned seed = 1;
+  std::string trace;
+};
+
+/// A random distribution is given as its two arguments, a workload as its
+/// size, a file by its name
+struct InputSpec {
+  std::string name;
+  bool random = false;
+  const workload::Workload* workload = nullptr;
+  std::size_t num_points = 0;
+  double radius = 0.0;
+};
+
+struct StatField {
+  const char* name;
+  double (*get)(const p2t::TriangulationStats&);
+};
+
+#define P2T_BENCH_STAT(field)                                                                  \
+  {                                                                                            \
+    #field, [](const p2t::TriangulationStats& stats) { return static_cast<double>(stats.field); } \
+  }
+
+/// The fields of CDT::GetStats reported with each run, in builds that keep them
+const std::vector<StatField>& StatFields()
+{
+  static const std::vector<StatField> fields = {
+#ifdef POLY2TRI_STATS
+    P2T_BENCH_STAT(init_ms),        P2T_BENCH_STAT(sweep_ms),
+    P2T_BENCH_STAT(finalize_ms),    P2T_BENCH_STAT(legalize),
+    P2T_BENCH_STAT(flips),          P2T_BENCH_STAT(edge_flips),
+    P2T_BENCH_STAT(edge_events),    P2T_BENCH_STAT(fills),
+    P2T_BENCH_STAT(fill_basin),     P2T_BENCH_STAT(locate_node),
+    P2T_BENCH_STAT(locate_node_steps), P2T_BENCH_STAT(max_front),
+    P2T_BENCH_STAT(orient2d),       P2T_BENCH_STAT(orient2d_exact),
+    P2T_BENCH_STAT(incircle),       P2T_BENCH_STAT(incircle_exact),
+#endif
+  };
+  return fields;
+}
+
+/// Counts as integers, times to the microsecond
+std::string Format(double value)
+{
+  char text[32];
+  std::snprintf(text, sizeof(text), std::floor(value) == value ? "%.0f" : "%.3f", value);
+  return text;
+}
+
+/// One triangulation: CDT construction and the adding of holes and Steiner
+/// points, Triangulate, and the destruction of the CDT
+struct Run {
+  double setup_ms = 0.0;
+  double triangulate_ms = 0.0;
+  double teardown_ms = 0.0;
+  std::size_t triangles = 0;
+  std::uint64_t allocations = 0;
+  std::uint64_t peak_rss_kib = 0;
+  /// Values of StatFields
+  std::vector<double> stats;
+
+  double total_ms() const { return setup_ms + triangulate_ms + teardown_ms; }
+  double triangles_per_s() const
+  {
+    return triangulate_ms > 0 ? 1e3 * triangles / triangulate_ms : 0.0;
+  }
+};
+
+Run Triangulate(const bench::Input& input, p2t::Tracer* tracer)
+{
+  Run run;
+  const std::uint64_t allocations = bench::AllocationCount().load();
+  bench::Timer setup;
+  auto cdt = new p2t::CDT(input.polyline);
+  cdt->SetTracer(tracer);
+  for (const auto& hole : input.holes) {
+    cdt->AddHole(hole);
+  }
+  for (auto p : input.steiner) {
+    cdt->AddPoint(p);
+  }
+  run.setup_ms = setup.Elapsed();
+
+  bench::Timer triangulate;
+  cdt->Triangulate();
+  run.triangulate_ms = triangulate.Elapsed();
+  run.triangles = cdt->GetTriangles().size();
+  for (const StatField& field : StatFields()) {
+    run.stats.push_back(field.get(cdt->GetStats()));
+  }
+
+  bench::Timer teardown;
+  delete cdt;
+  run.teardown_ms = teardown.Elapsed();
+  run.allocations = bench::AllocationCount().load() - allocations;
+  run.peak_rss_kib = PeakRss();
+  return run;
+}
+
+double Median(std::vector<double> values)
+{
+  std::sort(values.begin(), values.end());
+  const std::size_t n = values.size();
+  return n % 2 ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+/// The median of each phase over the runs, with their total the sum of those
+Run MedianRun(const std::vector<Run>& runs)
+{
+  const auto median = [&runs](double (*measure)(const Run&)) {
+    std::vector<double> values;
+    for (const Run& run : runs) {
+      values.push_back(measure(run));
+    }
+    return Median(values);
+  };
+  Run run;
+  run.setup_ms = median([](const Run& r) { return r.setup_ms; });
+  run.triangulate_ms = median([](const Run& r) { return r.triangulate_ms; });
+  run.teardown_ms = median([](const Run& r) { return r.teardown_ms; });
+  run.allocations = static_cast<std::uint64_t>(
+      median([](const Run& r) { return static_cast<double>(r.allocations); }));
+  run.triangles = runs.back().triangles;
+  run.peak_rss_kib = runs.back().peak_rss_kib;
+  for (std::size_t i = 0; i < StatFields().size(); ++i) {
+    std::vector<double> values;
+    for (const Run& r : runs) {
+      values.push_back(r.stats[i]);
+    }
+    run.stats.push_back(Median(values));
+  }
+  return run;
+}
+
+std::string JsonString(const std::string& s)
+{
+  std::string quoted = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+      quoted += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      quoted += escaped;
+    } else {
+      quoted += c;
+    }
+  }
+  return quoted + "\"";
+}
+
+void PrintCsvHeader()
+{
+  std::printf("input,points,load_ms,run,setup_ms,triangulate_ms,teardown_ms,total_ms,triangles,"
+              "triangles_per_s,allocations,peak_rss_kib");
+  for (const StatField& field : StatFields()) {
+    std::printf(",%s", field.name);
+  }
+  std::printf("\n");
+}
+
+void PrintCsvRow(const std::string& name, std::size_t points, double load_ms,
+                 const std::string& run_name, const Run& run)
+{
+  std::printf("%s,%zu,%.3f,%s,%.3f,%.3f,%.3f,%.3f,%zu,%.0f,%llu,%llu", name.c_str(), points,
+              load_ms, run_name.c_str(), run.setup_ms, run.triangulate_ms, run.teardown_ms,
+              run.total_ms(), run.triangles, run.triangles_per_s(),
+              static_cast<unsigned long long>(run.allocations),
+              static_cast<unsigned long long>(run.peak_rss_kib));
+  for (double value : run.stats) {
+    std::printf(",%s", Format(value).c_str());
+  }
+  std::printf("\n");
+}
+
+void PrintJsonRun(const Run& run)
+{
+  std::printf("{\"setup_ms\": %.3f, \"triangulate_ms\": %.3f, \"teardown_ms\": %.3f, "
+              "\"total_ms\": %.3f, \"triangles\": %zu, \"triangles_per_s\": %.0f, "
+              "\"allocations\": %llu, \"peak_rss_kib\": %llu",
+              run.setup_ms, run.triangulate_ms, run.teardown_ms, run.total_ms(), run.triangles,
+              run.triangles_per_s(), static_cast<unsigned long long>(run.allocations),
+              static_cast<unsigned long long>(run.peak_rss_kib));
+  if (!run.stats.empty()) {
+    std::printf(", \"stats\": {");
+    for (std::size_t i = 0; i < run.stats.size(); ++i) {
+      std::printf("%s\"%s\": %s", i ? ", " : "", StatFields()[i].name, Format(run.stats[i]).c_str());
+    }
+    std::printf("}");
+  }
+  std::printf("}");
+}
+
+void PrintJsonInput(const std::string& name, std::size_t points, double load_ms,
+                    const std::vector<Run>& runs, bool first)
+{
+  std::printf("%s\n  {\"input\": %s, \"points\": %zu, \"load_ms\": %.3f,\n   \"runs\": [",
+              first ? "" : ",", JsonString(name).c_str(), points, load_ms);
+  for (std::size_t i = 0; i < runs.size(); ++i) {
+    std::printf(i ? ",\n            " : "");
+    PrintJsonRun(runs[i]);
+  }
+  std::printf("],\n   \"median\": ");
+  PrintJsonRun(MedianRun(runs));
+  std::printf("}");
+}
+
+/// Writes the spans it gets as Chrome trace events, labelled with the input
+/// and run they are of
+class ChromeTracer : public p2t::Tracer {
+public:
+  explicit ChromeTracer(std::FILE* file) : file_(file), first_(true)
+  {
+    std::fprintf(file_, "{\"traceEvents\": [");
+  }
+
+  ~ChromeTracer() override { std::fprintf(file_, "\n]}\n"); }
+
+  void Begin(p2t::TracePhase phase, size_t arg) override { Write('B', phase, arg); }
+  void End(p2t::TracePhase phase, size_t arg) override { Write('E', phase, arg); }
+
+  /// Label of the runs that follow
+  void set_run(const std::string& input, int run)
+  {
+    input_ = JsonString(input);
+    run_ = run;
+  }
+
+private:
+  void Write(char type, p2t::TracePhase phase, size_t arg)
+  {
+    std::fprintf(file_,
+                 "%s\n  {\"name\": \"%s\", \"ph\": \"%c\", \"ts\": %.3f, \"pid\": 1, \"tid\": 1, "
+                 "\"args\": {\"input\": %s, \"run\": %d, \"arg\": %zu}}",
+                 first_ ? "" : ",", p2t::TracePhaseName(phase), type, 1e3 * clock_.Elapsed(),
+                 input_.c_str(), run_, arg);
+    first_ = false;
+  }
+
+  std::FILE* file_;
+  bool first_;
+  bench::Timer clock_;
+  std::string input_;
+  int run_ = 0;
+};
+
+int Usage()
+{
+  std::fprintf(stderr,
+               "Usage: p2t_bench [--repeat N] [--warmup N] [--format csv|json] [--seed N]\n"
+               "                 [--trace FILE] <input>...\n"
+               "  input: a .dat file, random <num_points> <box_radius>, or <workload> <num_points>\n"
+               "  Example: p2t_bench --repeat 10 testbed/data/nazca_monkey.dat random 100000 1\n"
+               "Workloads:\n");
+  for (const workload::Workload& workload : workload::Workloads()) {
+    std::fprintf(stderr, "  %-16s %s\n", workload.name, workload.loads);
+  }
+  return 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  std::vector<InputSpec> specs;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--repeat" && has_value) {
+      options.repeat = std::atoi(argv[++i]);
+    } else if (arg == "--warmup" && has_value) {
+      options.warmup = std::atoi(argv[++i]);
+    } else if (arg == "--seed" && has_value) {
+      options.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--trace" && has_value) {
+      options.trace = argv[++i];
+    } else if (arg == "--format" && has_value) {
+      const std::string format = argv[++i];
+      if (format != "csv" && format != "json") {
+        return Usage();
+      }
+      options.json = format == "json";
+    } else if (arg == "random" && i + 2 < argc) {
+      InputSpec spec;
+      spec.random = true;
+      spec.num_points = std::strtoull(argv[i + 1], nullptr, 10);
+      spec.radius = std::strtod(argv[i + 2], nullptr);
+      spec.name = "random " + std::string(argv[i + 1]) + " " + argv[i + 2];
+      specs.push_back(spec);
+      i += 2;
+    } else if (workload::FindWorkload(arg) && has_value) {
+      InputSpec spec;
+      spec.workload = workload::FindWorkload(arg);
+      spec.num_points = std::strtoull(argv[i + 1], nullptr, 10);
+      spec.name = arg + " " + argv[i + 1];
+      specs.push_back(spec);
+      ++i;
+    } else if (arg.compare(0, 2, "--") != 0) {
+      InputSpec spec;
+      spec.name = arg;
+      specs.push_back(spec);
+    } else {
+      return Usage();
+    }
+  }
+  if (specs.empty() || options.repeat < 1 || options.warmup < 0) {
+    return Usage();
+  }
+
+  // Closed after the tracer has ended its output
+  std::unique_ptr<std::FILE, int (*)(std::FILE*)> trace_file(nullptr, &std::fclose);
+  std::unique_ptr<ChromeTracer> tracer;
+  if (!options.trace.empty()) {
+    trace_file.reset(std::fopen(options.trace.c_str(), "w"));
+    if (!trace_file) {
+      std::fprintf(stderr, "%s: cannot open\n", options.trace.c_str());
+      return 2;
+    }
+    tracer.reset(new ChromeTracer(trace_file.get()));
+  }
+
+  int status = 0;
+  if (options.json) {
+    std::printf("[");
+  } else {
+    PrintCsvHeader();
+  }
+  bool first = true;
+  for (const InputSpec& spec : specs) {
+    bench::Input input;
+    bench::Timer load;
+    if (spec.random) {
+      // Each distribution is drawn from the seed, whatever came before it
+      srand(options.seed);
+      GenerateRandomPointDistribution(spec.num_points, -spec.radius, spec.radius, input.polyline,
+                                      input.holes, input.steiner);
+    } else if (spec.workload) {
+      input = bench::FromPolygon(spec.workload->make(spec.num_points, options.seed));
+    } else if (!ParseFile(spec.name, input.polyline, input.holes, input.steiner)) {
+      status = 2;
+      continue;
+    }
+    const double load_ms = load.Elapsed();
+
+    std::vector<Run> runs;
+    try {
+      for (int i = 0; i < options.warmup; ++i) {
+        Triangulate(input, nullptr);
+      }
+      for (int i = 0; i < options.repeat; ++i) {
+        if (tracer) {
+          tracer->set_run(spec.name, i);
+        }
+        runs.push_back(Triangulate(input, tracer.get()));
+      }
+    } catch (const std::exception& e) {
+      std::fprintf(stderr, "%s: %s\n", spec.name.c_str(), e.what());
+      status = 3;
+      continue;
+    }
+
+    if (options.json) {
+      PrintJsonInput(spec.name, input.size(), load_ms, runs, first);
+      first = false;
+    } else {
+      for (std::size_t i = 0; i < runs.size(); ++i) {
+        PrintCsvRow(spec.name, input.size(), load_ms, std::to_string(i), runs[i]);
+      }
+      PrintCsvRow(spec.name, input.size(), load_ms, "median", MedianRun(runs));
+    }
+    std::fflush(stdout);
+  }
+  if (options.json) {
+    std::printf("\n]\n");
+  }
+  return status;
+}
@@ -0,0 +1,86 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Point sort benchmark: the radix sort of SweepContext::InitTriangulation
+// against std::sort with cmp, which it replaced, on heap allocated points
+// in random order, already sorted and sorted on several threads.
+//
+// Usage: bench_point_sort [num_points]
+
+#include "bench_util.h"
+
+#include <poly2tri/sweep/point_sort.h>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+typedef void (*SortFunction)(std::vector<p2t::Point*>&);
+
+double Time(SortFunction sort, const std::vector<p2t::Point*>& points)
+{
+  std::vector<p2t::Point*> copy = points;
+  bench::Timer timer;
+  sort(copy);
+  return timer.Elapsed();
+}
+
+void Compare(const char* name, const std::vector<p2t::Point*>& points)
+{
+  const double std_ms =
+    Time([](std::vector<p2t::Point*>& v) { std::sort(v.begin(), v.end(), p2t::cmp); }, points);
+  const double radix_ms = Time([](std::vector<p2t::Point*>& v) { p2t::SortPoints(v, 1); }, points);
+  const double threads_ms =
+    Time([](std::vector<p2t::Point*>& v) { p2t::SortPoints(v, 4); }, points);
+  std::printf("%-24s %10zu %12.3f %12.3f %12.3f\n", name, points.size(), std_ms, radix_ms, threads_ms);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::size_t num_points = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+  std::printf("%-24s %10s %12s %12s %12s\n", "input", "points", "std::sort ms", "radix ms",
+              "4 threads ms");
+  for (std::size_t n = num_points / 100; n <= num_points; n *= 10) {
+    bench::Input input = bench::FromPolygon(workload::Uniform(n, 42));
+    std::vector<p2t::Point*> points = input.polyline;
+    points.insert(points.end(), input.steiner.begin(), input.steiner.end());
+    // Visit the points in scattered heap order, as sorting a long lived mesh does
+    std::shuffle(points.begin(), points.end(), std::mt19937_64(7));
+    Compare("random", points);
+    std::sort(points.begin(), points.end(), p2t::cmp);
+    Compare("sorted", points);
+  }
+  return 0;
+}
@@ -0,0 +1,164 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Predicate benchmark: throughput of the filtered Orient2d and Incircle
+// against calling the exact predicates directly, which is what every call
+// did before the filter, on random and on nearly degenerate inputs. Built
+// with POLY2TRI_PREDICATE_COUNTERS it also reports how often triangulation
+// falls back to exact arithmetic.
+//
+// Usage: bench_predicates [num_queries]
+
+#include "bench_util.h"
+
+#include <poly2tri/common/utils.h>
+
+#include <cstdio>
+
+namespace {
+
+std::array<double, 2> Coords(const p2t::Point& p)
+{
+  return { p.x, p.y };
+}
+
+// Quadruples of random points, or of points within a few ulps of a line
+std::vector<p2t::Point> Points(std::size_t n, bool degenerate)
+{
+  std::mt19937_64 rng(23);
+  std::uniform_real_distribution<double> coord(-1.0, 1.0);
+  std::uniform_int_distribution<int> ulps(-2, 2);
+  std::vector<p2t::Point> points;
+  points.reserve(4 * n);
+  for (std::size_t i = 0; i < 4 * n; ++i) {
+    const double x = coord(rng);
+    double y = coord(rng);
+    if (degenerate) {
+      y = 0.25 + 0.5 * x;
+      for (int k = ulps(rng); k != 0; k += k > 0 ? -1 : 1) {
+        y = std::nextafter(y, k > 0 ? 2.0 : -2.0);
+      }
+    }
+    points.emplace_back(x, y);
+  }
+  return points;
+}
+
+void CompareOrient2d(const char* name, const std::vector<p2t::Point>& points)
+{
+  const std::size_t n = points.size() / 4;
+  long long filtered_sum = 0;
+  bench::Timer filtered_timer;
+  for (std::size_t i = 0; i < n; ++i) {
+    filtered_sum += p2t::Orient2d(points[4 * i], points[4 * i + 1], points[4 * i + 2]);
+  }
+  const double filtered_ns = filtered_timer.Elapsed() * 1e6 / static_cast<double>(n);
+
+  long long exact_sum = 0;
+  bench::Timer exact_timer;
+  for (std::size_t i = 0; i < n; ++i) {
+    exact_sum += exact::orientation(Coords(points[4 * i]), Coords(points[4 * i + 1]),
+                                    Coords(points[4 * i + 2]));
+  }
+  const double exact_ns = exact_timer.Elapsed() * 1e6 / static_cast<double>(n);
+
+  std::printf("%-24s %12.2f %12.2f %8s\n", name, filtered_ns, exact_ns,
+              filtered_sum == exact_sum ? "" : "MISMATCH");
+}
+
+void CompareIncircle(const char* name, const std::vector<p2t::Point>& points)
+{
+  const std::size_t n = points.size() / 4;
+  std::size_t filtered_count = 0;
+  bench::Timer filtered_timer;
+  for (std::size_t i = 0; i < n; ++i) {
+    filtered_count += p2t::Incircle(points[4 * i], points[4 * i + 1], points[4 * i + 2],
+                                    points[4 * i + 3]);
+  }
+  const double filtered_ns = filtered_timer.Elapsed() * 1e6 / static_cast<double>(n);
+
+  std::size_t exact_count = 0;
+  bench::Timer exact_timer;
+  for (std::size_t i = 0; i < n; ++i) {
+    exact_count += exact::in_circumcircle(Coords(points[4 * i]), Coords(points[4 * i + 1]),
+                                          Coords(points[4 * i + 2]), Coords(points[4 * i + 3]))
+                   != geometrix::oriented_right;
+  }
+  const double exact_ns = exact_timer.Elapsed() * 1e6 / static_cast<double>(n);
+
+  std::printf("%-24s %12.2f %12.2f %8s\n", name, filtered_ns, exact_ns,
+              filtered_count == exact_count ? "" : "MISMATCH");
+}
+
+#ifdef POLY2TRI_PREDICATE_COUNTERS
+void ReportFallbacks(const char* name, const bench::Input& input)
+{
+  p2t::CDT cdt(input.polyline);
+  bench::AddInput(cdt, input);
+  cdt.Triangulate();
+  const p2t::TriangulationStats& stats = cdt.GetStats();
+  std::printf("%-24s %12llu %10llu %12llu %10llu\n", name,
+              static_cast<unsigned long long>(stats.orient2d),
+              static_cast<unsigned long long>(stats.orient2d_exact),
+              static_cast<unsigned long long>(stats.incircle),
+              static_cast<unsigned long long>(stats.incircle_exact));
+}
+#endif
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::size_t num_queries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+  const auto random = Points(num_queries, false);
+  const auto degenerate = Points(num_queries, true);
+
+  std::printf("%-24s %12s %12s\n", "orient2d", "filtered ns", "exact ns");
+  CompareOrient2d("random", random);
+  CompareOrient2d("nearly collinear", degenerate);
+  std::printf("\n%-24s %12s %12s\n", "incircle", "filtered ns", "exact ns");
+  CompareIncircle("random", random);
+  CompareIncircle("nearly collinear", degenerate);
+
+#ifdef POLY2TRI_PREDICATE_COUNTERS
+  std::printf("\n%-24s %12s %10s %12s %10s\n", "triangulation", "orient2d", "exact",
+              "incircle", "exact");
+  ReportFallbacks("random square", bench::FromPolygon(workload::Uniform(num_queries / 10, 42)));
+  for (const char* file : { "dude.dat", "nazca_monkey.dat", "kzer-za.dat" }) {
+    bench::Input input;
+    if (ParseFile(bench::DataFile(file), input.polyline, input.holes, input.steiner)) {
+      ReportFallbacks(file, input);
+    }
+  }
+#endif
+  return 0;
+}
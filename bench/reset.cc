@@ -0,0 +1,110 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Reset benchmark: a stream of small polygons triangulated with a new CDT
+// each, against one CDT that is reset for every polygon, in time and in heap
+// allocations per polygon once the stream has warmed up.
+//
+// Usage: bench_reset [num_polygons]
+
+#include "bench_util.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+const std::size_t kMaxPoints = 100;
+const std::size_t kWarmup = 100;
+
+// Refills points with a star shaped polygon of 50 to kMaxPoints points. The
+// points are reused from one polygon to the next.
+void NextPolygon(std::mt19937_64& rng, std::vector<p2t::Point>& storage,
+                 std::vector<p2t::Point*>& polyline)
+{
+  std::uniform_int_distribution<std::size_t> size(50, kMaxPoints);
+  std::uniform_real_distribution<double> radius(5, 10);
+  const std::size_t n = size(rng);
+  polyline.clear();
+  for (std::size_t i = 0; i < n; ++i) {
+    const double angle = 2 * M_PI * static_cast<double>(i) / static_cast<double>(n);
+    const double r = radius(rng);
+    storage[i].set(r * std::cos(angle), r * std::sin(angle));
+    polyline.push_back(&storage[i]);
+  }
+}
+
+template <class Triangulate>
+void Run(const char* name, std::size_t num_polygons, Triangulate triangulate)
+{
+  std::mt19937_64 rng(5);
+  std::vector<p2t::Point> storage(kMaxPoints);
+  std::vector<p2t::Point*> polyline;
+  polyline.reserve(kMaxPoints);
+  std::size_t triangles = 0;
+  for (std::size_t i = 0; i < kWarmup; ++i) {
+    NextPolygon(rng, storage, polyline);
+    triangles += triangulate(polyline);
+  }
+
+  const std::uint64_t allocations = bench::AllocationCount();
+  bench::Timer timer;
+  for (std::size_t i = 0; i < num_polygons; ++i) {
+    NextPolygon(rng, storage, polyline);
+    triangles += triangulate(polyline);
+  }
+  const double us = timer.Elapsed() * 1e3 / static_cast<double>(num_polygons);
+  const double per_polygon = static_cast<double>(bench::AllocationCount() - allocations) /
+                             static_cast<double>(num_polygons);
+  std::printf("%-24s %12.2f %16.2f %12zu\n", name, us, per_polygon, triangles);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::size_t num_polygons = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+  std::printf("%-24s %12s %16s %12s\n", "mode", "us/polygon", "allocs/polygon", "triangles");
+  Run("new CDT", num_polygons, [](std::vector<p2t::Point*>& polyline) {
+    p2t::CDT cdt(polyline);
+    cdt.Triangulate();
+    return cdt.GetTriangles().size();
+  });
+
+  p2t::CDT cdt(std::vector<p2t::Point*>{});
+  Run("reset CDT", num_polygons, [&cdt](std::vector<p2t::Point*>& polyline) {
+    cdt.Reset(polyline);
+    cdt.Triangulate();
+    return cdt.GetTriangles().size();
+  });
+  return 0;
+}
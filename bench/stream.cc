@@ -0,0 +1,113 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Streaming benchmark: a plain triangulation, which holds every triangle
+// until the end, against one passing the interior triangles to a sink as
+// the sweep finishes them and letting them go.
+//
+// Usage: bench_stream [num_points]
+
+#include "bench_util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+// Adds up the area of what it is passed, as a consumer would look at each
+// triangle, and samples how many triangles the CDT holds meanwhile
+class AreaSink : public p2t::TriangleSink {
+public:
+  explicit AreaSink(p2t::CDT& cdt) : cdt_(cdt) {}
+
+  void Consume(p2t::Triangle& t) override
+  {
+    const p2t::Point& a = *t.GetPoint(0);
+    const p2t::Point& b = *t.GetPoint(1);
+    const p2t::Point& c = *t.GetPoint(2);
+    area += 0.5 * ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x));
+    ++count;
+    peak = std::max(peak, cdt_.GetMap().size());
+  }
+
+  double area = 0;
+  std::size_t count = 0;
+  std::size_t peak = 0;
+
+private:
+  p2t::CDT& cdt_;
+};
+
+void Report(const char* name, double ms, std::size_t num_triangles, std::size_t held)
+{
+  std::printf("%-8s %12.1f %12zu %14zu %14.1f\n", name, ms, num_triangles, held,
+              static_cast<double>(held * sizeof(p2t::Triangle)) / (1 << 20));
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::size_t num_points = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+  const bench::Input input = bench::FromPolygon(workload::Uniform(num_points, 42));
+  std::printf("%-8s %12s %12s %14s %14s\n", "mode", "ms", "triangles", "most held", "MiB held");
+
+  double area = 0;
+  {
+    p2t::CDT cdt(input.polyline);
+    bench::AddInput(cdt, input);
+    bench::Timer timer;
+    cdt.Triangulate();
+    const double ms = timer.Elapsed();
+    for (p2t::Triangle* t : cdt.GetTriangles()) {
+      const p2t::Point& a = *t->GetPoint(0);
+      const p2t::Point& b = *t->GetPoint(1);
+      const p2t::Point& c = *t->GetPoint(2);
+      area += 0.5 * ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x));
+    }
+    Report("plain", ms, cdt.GetTriangles().size(), cdt.GetMap().size());
+  }
+
+  {
+    p2t::CDT cdt(input.polyline);
+    bench::AddInput(cdt, input);
+    AreaSink sink(cdt);
+    bench::Timer timer;
+    cdt.Triangulate(sink);
+    const double ms = timer.Elapsed();
+    Report("stream", ms, sink.count, sink.peak);
+    if (std::abs(sink.area - area) > 1e-9 * std::abs(area)) {
+      std::printf("MISMATCH\n");
+    }
+  }
+  return 0;
+}
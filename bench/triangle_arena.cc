@@ -0,0 +1,135 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Triangle allocation benchmark: heap allocations and wall time of a full
+// triangulation, and a head-to-head of per-triangle new/delete against the arena
+// now used by SweepContext.
+//
+// Usage: bench_triangle_arena [num_random_points...]
+
+#include "bench_util.h"
+
+#include <poly2tri/common/arena.h>
+
+#include <cstdio>
+#include <exception>
+
+namespace {
+
+void TriangulateAndReport(const char* name, const bench::Input& input)
+{
+  const auto allocations = bench::AllocationCount().load();
+  bench::Timer timer;
+  std::size_t triangles = 0;
+  std::size_t map_size = 0;
+  try {
+    p2t::CDT cdt(input.polyline);
+    bench::AddInput(cdt, input);
+    cdt.Triangulate();
+    triangles = cdt.GetTriangles().size();
+    map_size = cdt.GetMap().size();
+  } catch (std::exception& e) {
+    std::printf("%-24s failed: %s\n", name, e.what());
+    return;
+  }
+  const double ms = timer.Elapsed();
+  const auto count = bench::AllocationCount().load() - allocations;
+  std::printf("%-24s %10zu %10zu %10zu %12llu %10.3f %10.3f\n", name, input.size(), triangles,
+              map_size, static_cast<unsigned long long>(count),
+              static_cast<double>(count) / static_cast<double>(map_size), ms);
+}
+
+void CompareAllocators(std::size_t n)
+{
+  p2t::Point a(0, 0), b(1, 0), c(0, 1);
+  std::vector<p2t::Triangle*> triangles(n);
+
+  auto allocations = bench::AllocationCount().load();
+  bench::Timer heap_timer;
+  for (auto& t : triangles) {
+    t = new p2t::Triangle(a, b, c);
+  }
+  for (auto t : triangles) {
+    delete t;
+  }
+  const double heap_ms = heap_timer.Elapsed();
+  const auto heap_count = bench::AllocationCount().load() - allocations;
+
+  allocations = bench::AllocationCount().load();
+  bench::Timer arena_timer;
+  {
+    p2t::Arena<p2t::Triangle> arena;
+    for (auto& t : triangles) {
+      t = arena.Create(a, b, c);
+    }
+  }
+  const double arena_ms = arena_timer.Elapsed();
+  const auto arena_count = bench::AllocationCount().load() - allocations;
+
+  std::printf("%-24zu %12llu %10.3f %12llu %10.3f\n", n,
+              static_cast<unsigned long long>(heap_count), heap_ms,
+              static_cast<unsigned long long>(arena_count), arena_ms);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  std::vector<std::size_t> sizes;
+  for (int i = 1; i < argc; ++i) {
+    sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+  }
+  if (sizes.empty()) {
+    sizes = { 100000, 1000000 };
+  }
+
+  std::printf("%-24s %10s %10s %10s %12s %10s %10s\n", "input", "points", "triangles", "map",
+              "allocations", "per tri", "ms");
+  for (const char* file : { "2.dat", "bird.dat", "custom.dat", "debug.dat", "debug2.dat",
+                            "diamond.dat", "dude.dat", "funny.dat", "kzer-za.dat",
+                            "nazca_heron.dat", "nazca_monkey.dat", "stalactite.dat",
+                            "star.dat", "steiner.dat", "strange.dat", "tank.dat", "test.dat" }) {
+    bench::Input input;
+    if (ParseFile(bench::DataFile(file), input.polyline, input.holes, input.steiner)) {
+      TriangulateAndReport(file, input);
+    }
+  }
+  for (auto n : sizes) {
+    const auto input = bench::FromPolygon(workload::Uniform(n, 42));
+    TriangulateAndReport(("random " + std::to_string(n)).c_str(), input);
+  }
+
+  std::printf("\n%-24s %12s %10s %12s %10s\n", "triangles", "new/delete", "ms", "arena", "ms");
+  for (auto n : sizes) {
+    CompareAllocators(2 * n);
+  }
+  return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Validate benchmark: CDT::Validate on one and more threads, and IsDelaunay,
+// both of which test each edge against its neighbor, next to the check of
+// every point against every circumcircle that IsDelaunay made before, on an
+// input small enough for it.
+//
+// Usage: bench_validate [num_points]
+
+#include "bench_util.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+// The former IsDelaunay, for comparison
+bool AllPairsDelaunay(const std::vector<p2t::Triangle*>& triangles)
+{
+  for (const p2t::Triangle* triangle : triangles) {
+    for (p2t::Triangle* other : triangles) {
+      if (triangle == other) {
+        continue;
+      }
+      for (int i = 0; i < 3; ++i) {
+        if (triangle->CircumcicleContains(*other->GetPoint(i))) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void Report(const char* name, std::size_t num_triangles, double ms, const char* result)
+{
+  std::printf("%-22s %12.2f %14.1f   %s\n", name, ms, 1e-3 * num_triangles / ms, result);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::size_t num_points = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  const bench::Input input = bench::FromPolygon(workload::Uniform(num_points, 42));
+  p2t::CDT cdt(input.polyline);
+  bench::AddInput(cdt, input);
+  bench::Timer triangulate;
+  cdt.Triangulate();
+  const std::vector<p2t::Triangle*>& triangles = cdt.GetTriangles();
+  std::printf("%zu triangles, triangulate %.1f ms\n\n", triangles.size(), triangulate.Elapsed());
+  std::printf("%-22s %12s %14s   %s\n", "check", "ms", "Mtriangles/s", "result");
+
+  char result[128];
+  const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned num_threads : { 1u, 2u, cores }) {
+    bench::Timer timer;
+    const p2t::MeshReport report = cdt.Validate(num_threads);
+    const double ms = timer.Elapsed();
+    std::snprintf(result, sizeof(result), "ccw %zu neighbors %zu constraints %zu delaunay %zu edges %zu",
+                  report.not_ccw, report.bad_neighbors, report.bad_constraints,
+                  report.not_delaunay, report.missing_edges);
+    char name[32];
+    std::snprintf(name, sizeof(name), "Validate, %u threads", num_threads);
+    Report(name, triangles.size(), ms, result);
+  }
+
+  bench::Timer is_delaunay;
+  const bool delaunay = p2t::IsDelaunay(triangles);
+  Report("IsDelaunay", triangles.size(), is_delaunay.Elapsed(), delaunay ? "true" : "false");
+
+  // All pairs takes minutes beyond a few thousand triangles
+  const bench::Input small = bench::FromPolygon(workload::Uniform(2000, 42));
+  p2t::CDT small_cdt(small.polyline);
+  bench::AddInput(small_cdt, small);
+  small_cdt.Triangulate();
+  const std::vector<p2t::Triangle*>& small_triangles = small_cdt.GetTriangles();
+  std::printf("\n%zu triangles\n", small_triangles.size());
+  bench::Timer local;
+  const bool local_result = p2t::IsDelaunay(small_triangles);
+  Report("IsDelaunay", small_triangles.size(), local.Elapsed(), local_result ? "true" : "false");
+  bench::Timer all_pairs;
+  const bool all_pairs_result = AllPairsDelaunay(small_triangles);
+  Report("all pairs", small_triangles.size(), all_pairs.Elapsed(),
+         all_pairs_result ? "true" : "false");
+  return 0;
+}
@@ -0,0 +1,186 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace p2t {
+
+/**
+ * Chunked arena for objects of a single type.
+ *
+ * Objects are constructed in place, in allocation order, inside fixed-size blocks so
+ * that objects created one after another end up next to each other in memory. They are
+ * never freed individually: Clear() destroys every object but keeps the blocks for
+ * reuse, and the destructor hands the blocks back to the allocator.
+ */
+template <typename T, std::size_t BlockSize = 1024>
+class Arena {
+public:
+  Arena() : size_(0)
+  {
+  }
+
+  ~Arena()
+  {
+    Clear();
+    for (auto block : blocks_) {
+      ::operator delete(block);
+    }
+  }
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /// Construct a new object at the end of the arena
+  template <typename... Args>
+  T* Create(Args&&... args)
+  {
+    if (size_ == blocks_.size() * BlockSize) {
+      blocks_.push_back(static_cast<T*>(::operator new(sizeof(T) * BlockSize)));
+    }
+    T* slot = blocks_[size_ / BlockSize] + size_ % BlockSize;
+    new (slot) T(std::forward<Args>(args)...);
+    ++size_;
+    return slot;
+  }
+
+  /// Object at the given position in allocation order
+  T& operator[](std::size_t index)
+  {
+    return blocks_[index / BlockSize][index % BlockSize];
+  }
+
+  const T& operator[](std::size_t index) const
+  {
+    return blocks_[index / BlockSize][index % BlockSize];
+  }
+
+  /// Destroy all objects, keeping the allocated blocks
+  void Clear()
+  {
+    if (!std::is_trivially_destructible<T>::value) {
+      for (std::size_t i = 0; i < size_; ++i) {
+        blocks_[i / BlockSize][i % BlockSize].~T();
+      }
+    }
+    size_ = 0;
+  }
+
+  /// Number of live objects
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  /// Number of blocks obtained from the allocator
+  std::size_t block_count() const
+  {
+    return blocks_.size();
+  }
+
+  /// Bytes obtained from the allocator, the blocks and the list of them
+  std::size_t reserved_bytes() const
+  {
+    return blocks_.size() * BlockSize * sizeof(T) + blocks_.capacity() * sizeof(T*);
+  }
+
+private:
+  std::vector<T*> blocks_;
+  std::size_t size_;
+};
+
+/**
+ * Arena whose objects can also be released one at a time.
+ *
+ * Released slots go on a free list and are handed out again by Create() before the
+ * arena grows, so the memory in use follows the number of live objects rather than the
+ * number ever created. Releasing does not touch the object's memory.
+ */
+template <typename T, std::size_t BlockSize = 1024>
+class Pool {
+public:
+  /// Construct a new object, reusing a released slot if there is one
+  template <typename... Args>
+  T* Create(Args&&... args)
+  {
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "Pool only holds trivially destructible objects");
+    if (free_.empty()) {
+      return arena_.Create(std::forward<Args>(args)...);
+    }
+    T* slot = free_.back();
+    free_.pop_back();
+    return new (slot) T(std::forward<Args>(args)...);
+  }
+
+  /// Give an object's slot back to the pool
+  void Release(T* object)
+  {
+    free_.push_back(object);
+  }
+
+  /// Release every object, keeping the allocated blocks
+  void Clear()
+  {
+    arena_.Clear();
+    free_.clear();
+  }
+
+  /// Number of live objects
+  std::size_t size() const
+  {
+    return arena_.size() - free_.size();
+  }
+
+  /// Number of slots ever handed out; the pool's high-water mark
+  std::size_t capacity() const
+  {
+    return arena_.size();
+  }
+
+  /// Bytes obtained from the allocator, including the free list
+  std::size_t reserved_bytes() const
+  {
+    return arena_.reserved_bytes() + free_.capacity() * sizeof(T*);
+  }
+
+private:
+  Arena<T, BlockSize> arena_;
+  std::vector<T*> free_;
+};
+
+} // namespace p2t
@@ -0,0 +1,143 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace p2t {
+
+template <class Kernel> class BasicCDT;
+
+/// Opposite corner of an edge with no triangle on the other side
+const std::uint32_t kNoCorner = 0xFFFFFFFF;
+
+/**
+ * Triangulation as a corner table of 32 bit indices.
+ *
+ * Corner 3 * t + i is point i of triangle t. Each corner holds the index of its point and
+ * the corner facing it across the opposite edge, or kNoCorner if the edge has no triangle
+ * on the other side, and each triangle a mask with bit i set if the edge opposite its
+ * corner i is constrained. That is 25 bytes per triangle, where a Triangle takes 64 plus
+ * the pointer to it. As the opposite corner also tells which edge of the neighbor is
+ * shared, stepping across an edge needs no search through the neighbor's points.
+ */
+class CompactMesh {
+public:
+  /// Number of triangles
+  std::size_t size() const
+  {
+    return constrained_.size();
+  }
+
+  bool empty() const
+  {
+    return constrained_.empty();
+  }
+
+  /// Remove every triangle, keeping the memory
+  void Clear()
+  {
+    Resize(0);
+  }
+
+  /// Triangle a corner belongs to
+  static std::uint32_t TriangleOf(std::uint32_t corner)
+  {
+    return corner / 3;
+  }
+
+  /// The next corner counter clockwise in the same triangle
+  static std::uint32_t Next(std::uint32_t corner)
+  {
+    return corner % 3 == 2 ? corner - 2 : corner + 1;
+  }
+
+  /// The next corner clockwise in the same triangle
+  static std::uint32_t Prev(std::uint32_t corner)
+  {
+    return corner % 3 == 0 ? corner + 2 : corner - 1;
+  }
+
+  /// Index of the point at a corner
+  std::uint32_t Vertex(std::uint32_t corner) const
+  {
+    return vertices_[corner];
+  }
+
+  /// Corner across the edge opposite a corner, or kNoCorner
+  std::uint32_t Opposite(std::uint32_t corner) const
+  {
+    return opposite_[corner];
+  }
+
+  /// Is the edge opposite a corner constrained?
+  bool IsConstrained(std::uint32_t corner) const
+  {
+    return (constrained_[corner / 3] >> (corner % 3)) & 1;
+  }
+
+  /// Point indices, three per triangle
+  const std::vector<std::uint32_t>& vertices() const
+  {
+    return vertices_;
+  }
+
+  /// Opposite corners, three per triangle
+  const std::vector<std::uint32_t>& opposites() const
+  {
+    return opposite_;
+  }
+
+  /// Constrained edge masks, one per triangle
+  const std::vector<std::uint8_t>& constrained() const
+  {
+    return constrained_;
+  }
+
+private:
+  template <class Kernel> friend class BasicCDT;
+
+  void Resize(std::size_t num_triangles)
+  {
+    vertices_.resize(3 * num_triangles);
+    opposite_.resize(3 * num_triangles);
+    constrained_.resize(num_triangles);
+  }
+
+  std::vector<std::uint32_t> vertices_;
+  std::vector<std::uint32_t> opposite_;
+  std::vector<std::uint8_t> constrained_;
+};
+
+} // namespace p2t
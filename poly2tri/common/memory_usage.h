@@ -0,0 +1,114 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace p2t {
+
+/// Bytes of one kind of structure of a CDT, see MemoryReport
+struct MemoryUsage {
+  /// In use when asked
+  std::size_t live = 0;
+  /// Most in use at once since the triangulation started
+  std::size_t peak = 0;
+  /// Obtained from the allocator, at least peak. Kept by Reset for the next
+  /// triangulation.
+  std::size_t reserved = 0;
+
+  /// Add a list whose elements are all in use, as the sorted points are
+  template <class T>
+  void Add(const std::vector<T>& list)
+  {
+    live += list.size() * sizeof(T);
+    peak += list.size() * sizeof(T);
+    reserved += list.capacity() * sizeof(T);
+  }
+
+  /// Add a worklist or buffer, which counts as in use whole: it is kept at
+  /// the largest size it needed
+  template <class T>
+  void AddBuffer(const std::vector<T>& buffer)
+  {
+    AddBuffer(buffer.capacity() * sizeof(T));
+  }
+
+  void AddBuffer(std::size_t bytes)
+  {
+    live += bytes;
+    peak += bytes;
+    reserved += bytes;
+  }
+
+  MemoryUsage& operator+=(const MemoryUsage& other)
+  {
+    live += other.live;
+    peak += other.peak;
+    reserved += other.reserved;
+    return *this;
+  }
+};
+
+/**
+ * Memory of a CDT by kind of structure, see CDT::GetMemoryUsage. Asked
+ * during a triangulation, for instance from a Tracer, live is the memory in
+ * use then and peak the most so far.
+ */
+struct MemoryReport {
+  /// All triangles, those outside the polygon too, and the list of the
+  /// interior ones
+  MemoryUsage triangles;
+  /// Advancing front nodes, and the table of the points on the front
+  MemoryUsage nodes;
+  /// Constrained edges and the tables of them by point
+  MemoryUsage edges;
+  /// The points in input and in sweep order, and the CDT's own points and
+  /// index of them
+  MemoryUsage points;
+  /// Sort buffers, worklists of the sweep and the state of streaming
+  MemoryUsage scratch;
+
+  /// Sum of the kinds. Its peak may be more than was in use at once, as the
+  /// kinds need not peak together.
+  MemoryUsage total() const
+  {
+    MemoryUsage sum = triangles;
+    sum += nodes;
+    sum += edges;
+    sum += points;
+    sum += scratch;
+    return sum;
+  }
+};
+
+} // namespace p2t
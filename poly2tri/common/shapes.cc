@@ -30,7 +30,9 @@
  */
 #include "shapes.h"
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
 #include <iostream>
 
 namespace p2t {
@@ -46,6 +48,10 @@ Triangle::Triangle(Point& a, Point& b, Point& c)
   constrained_edge[0] = constrained_edge[1] = constrained_edge[2] = false;
   delaunay_edge[0] = delaunay_edge[1] = delaunay_edge[2] = false;
   interior_ = false;
+  final_ = false;
+  classified_ = false;
+  harvest_wait_ = 0;
+  interior_index_ = 0;
 }
 
 // Update neighbor pointers
@@ -387,13 +393,32 @@ bool Triangle::IsCounterClockwise() const
 
 bool IsDelaunay(const std::vector<p2t::Triangle*>& triangles)
 {
+  // Triangles from GetTriangles know their position among them. Any others
+  // are looked up in a sorted copy.
+  std::vector<Triangle*> sorted;
+  for (size_t k = 0; k < triangles.size() && sorted.empty(); ++k) {
+    const size_t index = triangles[k]->InteriorIndex();
+    if (index >= triangles.size() || triangles[index] != triangles[k]) {
+      sorted = triangles;
+      std::sort(sorted.begin(), sorted.end(), std::less<Triangle*>());
+    }
+  }
+  const auto contains = [&triangles, &sorted](Triangle* t) {
+    if (sorted.empty()) {
+      const size_t index = t->InteriorIndex();
+      return index < triangles.size() && triangles[index] == t;
+    }
+    return std::binary_search(sorted.begin(), sorted.end(), t, std::less<Triangle*>());
+  };
+
+  // Being locally Delaunay across every edge that is not constrained makes
+  // the whole set constrained Delaunay
   for (const auto triangle : triangles) {
-    for (const auto other : triangles) {
-      if (triangle == other) {
-        continue;
-      }
-      for (int i = 0; i < 3; ++i) {
-        if (triangle->CircumcicleContains(*other->GetPoint(i))) {
+    for (int i = 0; i < 3; ++i) {
+      Triangle* neighbor = triangle->GetNeighbor(i);
+      if (neighbor && !triangle->constrained_edge[i] && contains(neighbor)) {
+        const Point& far = *neighbor->OppositePoint(*triangle, *triangle->GetPoint(i));
+        if (triangle->CircumcicleContains(far)) {
           return false;
         }
       }
@@ -32,6 +32,7 @@
 
 #include "../poly2tri_export.h"
 #include <cstddef>
+#include <cstdint>
 #include <cmath>
 #include <stdexcept>
 #include <vector>
@@ -39,8 +40,6 @@
 
 namespace p2t {
 
-struct Edge;
-
 struct POLY2TRI_API Point {
 
   double x, y;
@@ -52,9 +51,6 @@ struct POLY2TRI_API Point {
   {
   }
 
-  /// The edges this point constitutes an upper ending point
-  std::vector<Edge*> edge_list;
-
   /// Construct using coordinates.
   Point(double x, double y) 
       : x{ x }
@@ -144,8 +140,6 @@ struct POLY2TRI_API Edge {
         //GEOMETRIX_ASSERT(false);
       }
     }
-
-    q->edge_list.push_back(this);
   }
 };
 
@@ -207,6 +201,22 @@ void ClearDelunayEdges();
 inline bool IsInterior();
 inline void IsInterior(bool b);
 
+/// Position among the interior triangles, as listed by the sweep context
+inline std::uint32_t InteriorIndex() const;
+inline void InteriorIndex(std::uint32_t index);
+
+/// Is the sweep done changing this triangle? Only tracked when streaming
+inline bool IsFinal() const;
+inline void IsFinal(bool b);
+
+/// Is IsInterior known? Only tracked when streaming
+inline bool IsClassified() const;
+inline void IsClassified(bool b);
+
+/// Harvests to skip before checking IsFinal again, a hint only
+inline std::uint8_t HarvestWait() const;
+inline void HarvestWait(std::uint8_t harvests);
+
 void DebugPrint();
 
 bool CircumcicleContains(const Point&) const;
@@ -222,6 +232,12 @@ Triangle* neighbors_[3];
 
 /// Has this triangle been marked as an interior triangle?
 bool interior_;
+/// Streaming state, see SweepContext::Harvest
+bool final_;
+bool classified_;
+std::uint8_t harvest_wait_;
+/// Fits in what would be padding after interior_
+std::uint32_t interior_index_;
 };
 
 inline bool cmp(const Point* a, const Point* b)
@@ -325,7 +341,50 @@ inline void Triangle::IsInterior(bool b)
 {
   interior_ = b;
 }
-/// Is this set a valid delaunay triangulation?
+
+inline std::uint32_t Triangle::InteriorIndex() const
+{
+  return interior_index_;
+}
+
+inline void Triangle::InteriorIndex(std::uint32_t index)
+{
+  interior_index_ = index;
+}
+
+inline bool Triangle::IsFinal() const
+{
+  return final_;
+}
+
+inline void Triangle::IsFinal(bool b)
+{
+  final_ = b;
+}
+
+inline bool Triangle::IsClassified() const
+{
+  return classified_;
+}
+
+inline void Triangle::IsClassified(bool b)
+{
+  classified_ = b;
+}
+
+inline std::uint8_t Triangle::HarvestWait() const
+{
+  return harvest_wait_;
+}
+
+inline void Triangle::HarvestWait(std::uint8_t harvests)
+{
+  harvest_wait_ = harvests;
+}
+/// Is this set a valid delaunay triangulation? Checks each edge that is not
+/// constrained against the neighbor across it, if that is in the set, in
+/// linear time for the triangles of CDT::GetTriangles. See CDT::Validate
+/// for a fuller check.
 POLY2TRI_API bool IsDelaunay(const std::vector<p2t::Triangle*>&);
 
 struct poly2tri_exception : std::runtime_error
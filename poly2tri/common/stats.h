@@ -0,0 +1,94 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Builds with POLY2TRI_STATS (the CMake option P2T_STATS) keep the counters
+// and timers of TriangulationStats. They count predicate calls as well, as
+// POLY2TRI_PREDICATE_COUNTERS does on its own.
+#if defined(POLY2TRI_STATS) && !defined(POLY2TRI_PREDICATE_COUNTERS)
+#define POLY2TRI_PREDICATE_COUNTERS
+#endif
+
+/// A statement kept only in builds with POLY2TRI_STATS
+#ifdef POLY2TRI_STATS
+#define POLY2TRI_STAT(statement) statement
+#else
+#define POLY2TRI_STAT(statement)
+#endif
+
+namespace p2t {
+
+/**
+ * What the last triangulation did, see CDT::GetStats. Only flips is counted
+ * in every build. The predicate counts need POLY2TRI_PREDICATE_COUNTERS or
+ * POLY2TRI_STATS, and the others POLY2TRI_STATS; without, they stay zero.
+ */
+struct TriangulationStats
+{
+  /// Calls of Legalize
+  std::uint64_t legalize = 0;
+  /// Edges flipped by Legalize
+  std::uint64_t flips = 0;
+  /// Edges flipped to insert constrained edges
+  std::uint64_t edge_flips = 0;
+  /// Constrained edges inserted, as EdgeEvent calls
+  std::uint64_t edge_events = 0;
+  /// Triangles added by Fill to close the front
+  std::uint64_t fills = 0;
+  /// Calls of FillBasin
+  std::uint64_t fill_basin = 0;
+  /// Calls of LocateNode, one for each point swept, and the nodes of the
+  /// front's search tree they visited
+  std::uint64_t locate_node = 0;
+  std::uint64_t locate_node_steps = 0;
+  /// Most nodes on the advancing front at once
+  std::size_t max_front = 0;
+
+  /// Predicate calls, and those that the floating point filter left to
+  /// exact arithmetic
+  std::uint64_t orient2d = 0;
+  std::uint64_t orient2d_exact = 0;
+  std::uint64_t incircle = 0;
+  std::uint64_t incircle_exact = 0;
+
+  /// Wall time in milliseconds of InitTriangulation (bounds, sentinels and
+  /// the sort of the points), of the sweep over the points, and of
+  /// FinalizationPolygon (MeshClean, or the end of a stream)
+  double init_ms = 0;
+  double sweep_ms = 0;
+  double finalize_ms = 0;
+};
+
+} // namespace p2t
@@ -0,0 +1,131 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "../poly2tri_export.h"
+
+#include <cstddef>
+
+namespace p2t {
+
+/// Spans of work reported to a Tracer
+enum class TracePhase {
+  /// A whole triangulation; arg is the number of points
+  kTriangulate,
+  /// Checking and sorting the points and setting up the advancing front
+  kInit,
+  /// The sweep over the points
+  kSweep,
+  /// Consecutive points of the sweep, Tracer::chunk_points of them but for
+  /// the last chunk; arg is the position of the first in sweep order
+  kSweepChunk,
+  /// Inserting a long constrained edge, see Tracer::long_edge; arg is the
+  /// position of its upper point in sweep order
+  kEdgeEvent,
+  /// MeshClean, or the end of a stream
+  kFinalize,
+  /// One input of a BatchTriangulator; arg is its index
+  kBatchInput
+};
+
+/// Name of a phase, such as "EdgeEvent", for trace viewers
+inline const char* TracePhaseName(TracePhase phase)
+{
+  switch (phase) {
+    case TracePhase::kTriangulate:
+      return "Triangulate";
+    case TracePhase::kInit:
+      return "Init";
+    case TracePhase::kSweep:
+      return "Sweep";
+    case TracePhase::kSweepChunk:
+      return "SweepChunk";
+    case TracePhase::kEdgeEvent:
+      return "EdgeEvent";
+    case TracePhase::kFinalize:
+      return "Finalize";
+    case TracePhase::kBatchInput:
+      return "BatchInput";
+  }
+  return "";
+}
+
+/**
+ * Receiver of the begin and end of each phase of a triangulation, to put
+ * them on a timeline; see CDT::SetTracer. Spans nest: every Begin is
+ * matched by an End with the same phase and arg before the enclosing span
+ * ends, also when the triangulation throws. End is called while unwinding
+ * then, so it must not throw. A sweep without a tracer only tests for one.
+ */
+class POLY2TRI_API Tracer {
+public:
+  virtual ~Tracer() {}
+
+  virtual void Begin(TracePhase phase, size_t arg) = 0;
+  virtual void End(TracePhase phase, size_t arg) = 0;
+
+  /// Points swept per kSweepChunk span
+  size_t chunk_points = 4096;
+  /// Constrained edges get a kEdgeEvent span if they are at least this
+  /// fraction of the height of the input tall
+  double long_edge = 0.25;
+};
+
+/// Begin of a span on construction and its end on destruction, if there is
+/// a tracer
+class TraceScope {
+public:
+  TraceScope(Tracer* tracer, TracePhase phase, size_t arg)
+    : tracer_(tracer), phase_(phase), arg_(arg)
+  {
+    if (tracer_) {
+      tracer_->Begin(phase_, arg_);
+    }
+  }
+
+  ~TraceScope()
+  {
+    if (tracer_) {
+      tracer_->End(phase_, arg_);
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+  Tracer* tracer_;
+  TracePhase phase_;
+  size_t arg_;
+};
+
+} // namespace p2t
@@ -33,10 +33,17 @@
 
 // Otherwise #defines like M_PI are undeclared under Visual Studio
 #define _USE_MATH_DEFINES
+// The exact predicates back FilteredExactKernel, the default kernel. Define
+// POLY2TRI_NO_EXACT to build without them.
+#ifndef POLY2TRI_NO_EXACT
 #define POLY2TRI_USE_EXACT
+#endif
 #include "orientation.h"
+#include "stats.h"
 #include <cmath>
+#include <cstdint>
 #include <exception>
+#include <limits>
 
 #ifdef POLY2TRI_USE_EXACT
 #include <exact/predicates.hpp>
@@ -47,63 +54,64 @@
 #define M_PI 3.14159265358979323846264338327
 #endif
 
+// Kernel predicates are inlined into every instantiation of the sweep
+#if defined(_MSC_VER)
+#define POLY2TRI_FORCE_INLINE __forceinline
+#elif defined(__GNUC__)
+#define POLY2TRI_FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define POLY2TRI_FORCE_INLINE inline
+#endif
+
 namespace p2t {
 
 const double PI_3div4 = 3 * M_PI / 4;
 const double PI_div2 = 1.57079632679489661923;
 const double EPSILON = 1e-12;
 
-inline Orientation Orient2dInexact(const Point& pa, const Point& pb, const Point& pc)
+#ifdef POLY2TRI_PREDICATE_COUNTERS
+/**
+ * Number of predicate calls made on this thread, and how many of them the
+ * floating point filter could not decide and passed on to exact arithmetic
+ */
+struct PredicateCounters
 {
-  double detleft = (pa.x - pc.x) * (pb.y - pc.y);
-  double detright = (pa.y - pc.y) * (pb.x - pc.x);
-  double val = detleft - detright;
-  if (val > -EPSILON && val < EPSILON) {
-    return COLLINEAR;
-  } else if (val > 0) {
-    return CCW;
-  }
-  return CW;
+  unsigned long long orient2d = 0;
+  unsigned long long orient2d_exact = 0;
+  unsigned long long incircle = 0;
+  unsigned long long incircle_exact = 0;
+};
+
+inline PredicateCounters& GetPredicateCounters()
+{
+  static thread_local PredicateCounters counters;
+  return counters;
 }
 
-/**
- * Formula to calculate signed area<br>
- * Positive if CCW<br>
- * Negative if CW<br>
- * 0 if collinear<br>
- * <pre>
- * A[P1,P2,P3]  =  (x1*y2 - y1*x2) + (x2*y3 - y2*x3) + (x3*y1 - y3*x1)
- *              =  (x1-x3)*(y2-y3) - (y1-y3)*(x2-x3)
- * </pre>
- */
-inline Orientation Orient2d(const Point& pa, const Point& pb, const Point& pc)
+#define POLY2TRI_COUNT_PREDICATE(counter) ++::p2t::GetPredicateCounters().counter
+#else
+#define POLY2TRI_COUNT_PREDICATE(counter)
+#endif
+
+// Relative error bounds of the floating point determinants in Orient2d and
+// Incircle, from Shewchuk, "Adaptive Precision Floating-Point Arithmetic and
+// Fast Robust Geometric Predicates". A determinant whose magnitude exceeds
+// the bound times its permanent has the sign it was computed with.
+const double PREDICATE_EPSILON = std::numeric_limits<double>::epsilon() / 2;
+const double ORIENT2D_ERRBOUND = (3.0 + 16.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+const double INCIRCLE_ERRBOUND = (10.0 + 96.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+
+inline Orientation Orient2dInexact(const Point& pa, const Point& pb, const Point& pc)
 {
-#ifndef POLY2TRI_USE_EXACT
   double detleft = (pa.x - pc.x) * (pb.y - pc.y);
   double detright = (pa.y - pc.y) * (pb.x - pc.x);
   double val = detleft - detright;
-
-// Using a tolerance here fails on concave-by-subepsilon boundaries
-//   if (val > -EPSILON && val < EPSILON) {
-// Using == on double makes -Wfloat-equal warnings yell at us
-  if (std::fpclassify(val) == FP_ZERO) {
+  if (val > -EPSILON && val < EPSILON) {
     return COLLINEAR;
-  }
-  else if (val > 0) 
-  {
+  } else if (val > 0) {
     return CCW;
   }
-  
   return CW;
-#else
-	std::array<double, 2> a = { pa.x, pa.y };
-	std::array<double, 2> b = { pb.x, pb.y };
-	std::array<double, 2> c = { pc.x, pc.y };
-
-	auto r = static_cast<Orientation>(exact::orientation(a, b, c));
-    //GEOMETRIX_ASSERT(Orient2dInexact(pa, pb, pc) == (Orientation)r);
-    return r;
-#endif
 }
 
 /*
@@ -154,41 +162,339 @@ inline bool InScanAreaInexact(const Point& pa, const Point& pb, const Point& pc,
 	return true;
 }
 
-inline bool InScanArea(const Point& pa, const Point& pb, const Point& pc, const Point& pd)
+/**
+ * Predicates in plain double arithmetic. Fast, but nearly degenerate input
+ * can get inconsistent answers.
+ */
+struct InexactKernel
 {
-#ifndef POLY2TRI_USE_EXACT
-  double oadb = (pa.x - pb.x)*(pd.y - pb.y) - (pd.x - pb.x)*(pa.y - pb.y);
-  if (oadb >= -EPSILON) {
-    return false;
+  /// Whether the predicates require integral coordinates
+  static const bool integral_coordinates = false;
+
+  /// Whether the predicates are reliable for p
+  static bool Accepts(const Point&) { return true; }
+
+  /**
+   * Formula to calculate signed area<br>
+   * Positive if CCW<br>
+   * Negative if CW<br>
+   * 0 if collinear<br>
+   * <pre>
+   * A[P1,P2,P3]  =  (x1*y2 - y1*x2) + (x2*y3 - y2*x3) + (x3*y1 - y3*x1)
+   *              =  (x1-x3)*(y2-y3) - (y1-y3)*(x2-x3)
+   * </pre>
+   */
+  POLY2TRI_FORCE_INLINE static Orientation Orient2d(const Point& pa, const Point& pb, const Point& pc)
+  {
+    POLY2TRI_COUNT_PREDICATE(orient2d);
+
+    double detleft = (pa.x - pc.x) * (pb.y - pc.y);
+    double detright = (pa.y - pc.y) * (pb.x - pc.x);
+    double val = detleft - detright;
+
+  // Using a tolerance here fails on concave-by-subepsilon boundaries
+  //   if (val > -EPSILON && val < EPSILON) {
+  // Using == on double makes -Wfloat-equal warnings yell at us
+    if (std::fpclassify(val) == FP_ZERO) {
+      return COLLINEAR;
+    }
+    else if (val > 0)
+    {
+      return CCW;
+    }
+
+    return CW;
   }
 
-  double oadc = (pa.x - pc.x)*(pd.y - pc.y) - (pd.x - pc.x)*(pa.y - pc.y);
-  if (oadc <= EPSILON) {
-    return false;
+  POLY2TRI_FORCE_INLINE static bool InScanArea(const Point& pa, const Point& pb, const Point& pc, const Point& pd)
+  {
+    double oadb = (pa.x - pb.x)*(pd.y - pb.y) - (pd.x - pb.x)*(pa.y - pb.y);
+    if (oadb >= -EPSILON) {
+      return false;
+    }
+
+    double oadc = (pa.x - pc.x)*(pd.y - pc.y) - (pd.x - pc.x)*(pa.y - pc.y);
+    if (oadc <= EPSILON) {
+      return false;
+    }
+    return true;
   }
-  return true;
-#else
-	std::array<double, 2> a = { pa.x, pa.y };
-	std::array<double, 2> b = { pb.x, pb.y };
-	std::array<double, 2> c = { pc.x, pc.y };
-	std::array<double, 2> d = { pd.x, pd.y };
 
-	if (exact::orientation(b, a, d) != geometrix::oriented_right)
-    {
-        //GEOMETRIX_ASSERT(!InScanAreaInexact(pa,pb,pc,pd));
-        return false;
+  /**
+   * True if pd is inside the circle through pa, pb and pc, which must be in
+   * counterclockwise order, with pd in the area opposite pa, see
+   * Sweep::Incircle
+   */
+  POLY2TRI_FORCE_INLINE static bool Incircle(const Point& pa, const Point& pb, const Point& pc, const Point& pd)
+  {
+    POLY2TRI_COUNT_PREDICATE(incircle);
+
+    const double adx = pa.x - pd.x;
+    const double ady = pa.y - pd.y;
+    const double bdx = pb.x - pd.x;
+    const double bdy = pb.y - pd.y;
+
+    const double adxbdy = adx * bdy;
+    const double bdxady = bdx * ady;
+    const double oabd = adxbdy - bdxady;
+
+    if (oabd <= 0)
+      return false;
+
+    const double cdx = pc.x - pd.x;
+    const double cdy = pc.y - pd.y;
+
+    const double cdxady = cdx * ady;
+    const double adxcdy = adx * cdy;
+    const double ocad = cdxady - adxcdy;
+
+    if (ocad <= 0)
+      return false;
+
+    const double bdxcdy = bdx * cdy;
+    const double cdxbdy = cdx * bdy;
+
+    const double alift = adx * adx + ady * ady;
+    const double blift = bdx * bdx + bdy * bdy;
+    const double clift = cdx * cdx + cdy * cdy;
+
+    const double det = alift * (bdxcdy - cdxbdy) + blift * ocad + clift * oabd;
+
+    return det > 0;
+  }
+};
+
+#ifdef POLY2TRI_USE_EXACT
+/**
+ * Exact predicates for any finite double coordinates. The determinants are
+ * evaluated in doubles first and only go to the exact predicates when their
+ * error bound leaves the sign in doubt.
+ */
+struct FilteredExactKernel
+{
+  static const bool integral_coordinates = false;
+
+  static bool Accepts(const Point&) { return true; }
+
+  POLY2TRI_FORCE_INLINE static Orientation Orient2d(const Point& pa, const Point& pb, const Point& pc)
+  {
+    POLY2TRI_COUNT_PREDICATE(orient2d);
+
+    // Nearly every call is decided by the floating point determinant
+    const double detleft = (pa.x - pc.x) * (pb.y - pc.y);
+    const double detright = (pa.y - pc.y) * (pb.x - pc.x);
+    const double det = detleft - detright;
+    const double errbound = ORIENT2D_ERRBOUND * (std::fabs(detleft) + std::fabs(detright));
+    if (det > errbound) {
+      return CCW;
     }
-	
-    if (exact::orientation(c, a, d) != geometrix::oriented_left)
-    {
-        //GEOMETRIX_ASSERT(!InScanAreaInexact(pa,pb,pc,pd));
-        return false;
+    if (-det > errbound) {
+      return CW;
     }
 
-    //GEOMETRIX_ASSERT(InScanAreaInexact(pa,pb,pc,pd));
-	return true;
+    POLY2TRI_COUNT_PREDICATE(orient2d_exact);
+    std::array<double, 2> a = { pa.x, pa.y };
+    std::array<double, 2> b = { pb.x, pb.y };
+    std::array<double, 2> c = { pc.x, pc.y };
+    return static_cast<Orientation>(exact::orientation(a, b, c));
+  }
+
+  POLY2TRI_FORCE_INLINE static bool InScanArea(const Point& pa, const Point& pb, const Point& pc, const Point& pd)
+  {
+    return Orient2d(pb, pa, pd) == CW && Orient2d(pc, pa, pd) == CCW;
+  }
+
+  /**
+   * True if pd is inside or on the circle through pa, pb and pc, which must
+   * be in counterclockwise order
+   */
+  POLY2TRI_FORCE_INLINE static bool Incircle(const Point& pa, const Point& pb, const Point& pc, const Point& pd)
+  {
+    POLY2TRI_COUNT_PREDICATE(incircle);
+
+    const double adx = pa.x - pd.x;
+    const double ady = pa.y - pd.y;
+    const double bdx = pb.x - pd.x;
+    const double bdy = pb.y - pd.y;
+    const double cdx = pc.x - pd.x;
+    const double cdy = pc.y - pd.y;
+
+    const double bdxcdy = bdx * cdy;
+    const double cdxbdy = cdx * bdy;
+    const double cdxady = cdx * ady;
+    const double adxcdy = adx * cdy;
+    const double adxbdy = adx * bdy;
+    const double bdxady = bdx * ady;
+
+    const double alift = adx * adx + ady * ady;
+    const double blift = bdx * bdx + bdy * bdy;
+    const double clift = cdx * cdx + cdy * cdy;
+
+    const double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy)
+                     + clift * (adxbdy - bdxady);
+    const double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * alift
+                           + (std::fabs(cdxady) + std::fabs(adxcdy)) * blift
+                           + (std::fabs(adxbdy) + std::fabs(bdxady)) * clift;
+    const double errbound = INCIRCLE_ERRBOUND * permanent;
+    if (det > errbound) {
+      return true;
+    }
+    if (-det > errbound) {
+      return false;
+    }
+
+    POLY2TRI_COUNT_PREDICATE(incircle_exact);
+    std::array<double, 2> a = { pa.x, pa.y };
+    std::array<double, 2> b = { pb.x, pb.y };
+    std::array<double, 2> c = { pc.x, pc.y };
+    std::array<double, 2> d = { pd.x, pd.y };
+    return exact::in_circumcircle(a, b, c, d) != geometrix::oriented_right;
+  }
+};
+#endif
+
+#ifdef __SIZEOF_INT128__
+/**
+ * Exact predicates in integer arithmetic, for inputs whose coordinates are
+ * integers of magnitude at most 2^28. This leaves room for the sentinel
+ * points, which lie up to 30% of the extent further out, while every
+ * determinant fits in 128 bits.
+ */
+struct IntegerExactKernel
+{
+  static const bool integral_coordinates = true;
+
+  static bool Accepts(const Point& p)
+  {
+    const double limit = 268435456.0; // 2^28
+    return std::fabs(p.x) <= limit && std::fabs(p.y) <= limit
+           && std::floor(p.x) == p.x && std::floor(p.y) == p.y;
+  }
+
+  POLY2TRI_FORCE_INLINE static Orientation Orient2d(const Point& pa, const Point& pb, const Point& pc)
+  {
+    POLY2TRI_COUNT_PREDICATE(orient2d);
+
+    const std::int64_t acx = Coord(pa.x) - Coord(pc.x);
+    const std::int64_t bcx = Coord(pb.x) - Coord(pc.x);
+    const std::int64_t acy = Coord(pa.y) - Coord(pc.y);
+    const std::int64_t bcy = Coord(pb.y) - Coord(pc.y);
+    const std::int64_t det = acx * bcy - acy * bcx;
+    return det > 0 ? CCW : (det < 0 ? CW : COLLINEAR);
+  }
+
+  POLY2TRI_FORCE_INLINE static bool InScanArea(const Point& pa, const Point& pb, const Point& pc, const Point& pd)
+  {
+    return Orient2d(pb, pa, pd) == CW && Orient2d(pc, pa, pd) == CCW;
+  }
+
+  POLY2TRI_FORCE_INLINE static bool Incircle(const Point& pa, const Point& pb, const Point& pc, const Point& pd)
+  {
+    POLY2TRI_COUNT_PREDICATE(incircle);
+
+    const std::int64_t adx = Coord(pa.x) - Coord(pd.x);
+    const std::int64_t ady = Coord(pa.y) - Coord(pd.y);
+    const std::int64_t bdx = Coord(pb.x) - Coord(pd.x);
+    const std::int64_t bdy = Coord(pb.y) - Coord(pd.y);
+    const std::int64_t cdx = Coord(pc.x) - Coord(pd.x);
+    const std::int64_t cdy = Coord(pc.y) - Coord(pd.y);
+
+    const __int128 alift = static_cast<__int128>(adx * adx + ady * ady);
+    const __int128 blift = static_cast<__int128>(bdx * bdx + bdy * bdy);
+    const __int128 clift = static_cast<__int128>(cdx * cdx + cdy * cdy);
+
+    const __int128 det = alift * (bdx * cdy - cdx * bdy) + blift * (cdx * ady - adx * cdy)
+                       + clift * (adx * bdy - bdx * ady);
+    return det >= 0;
+  }
+
+private:
+
+  static std::int64_t Coord(double v) { return static_cast<std::int64_t>(v); }
+};
 #endif
+
+/// Kernel used by Sweep and CDT, and by the predicates below unless told otherwise
+#ifdef POLY2TRI_USE_EXACT
+typedef FilteredExactKernel DefaultKernel;
+#else
+typedef InexactKernel DefaultKernel;
+#endif
+
+template <class Kernel = DefaultKernel>
+POLY2TRI_FORCE_INLINE Orientation Orient2d(const Point& pa, const Point& pb, const Point& pc)
+{
+  return Kernel::Orient2d(pa, pb, pc);
 }
 
-}//! namespace p2t;
+template <class Kernel = DefaultKernel>
+POLY2TRI_FORCE_INLINE bool InScanArea(const Point& pa, const Point& pb, const Point& pc, const Point& pd)
+{
+  return Kernel::InScanArea(pa, pb, pc, pd);
+}
 
+template <class Kernel = DefaultKernel>
+POLY2TRI_FORCE_INLINE bool Incircle(const Point& pa, const Point& pb, const Point& pc, const Point& pd)
+{
+  return Kernel::Incircle(pa, pb, pc, pd);
+}
+
+/*
+ * Angle tests of the front filling heuristics. The angle at origin from pa to
+ * pb is atan2(cross, dot) of the vectors to them; rather than computing it,
+ * the tests look at the signs of cross and dot. They follow atan2 on signed
+ * zeros too, so they agree with comparing the angle against the thresholds.
+ */
+
+inline void AngleCrossDot(const Point& origin, const Point& pa, const Point& pb, double& cross,
+                          double& dot)
+{
+  const double ax = pa.x - origin.x;
+  const double ay = pa.y - origin.y;
+  const double bx = pb.x - origin.x;
+  const double by = pb.y - origin.y;
+  cross = ax * by - ay * bx;
+  dot = ax * bx + ay * by;
+}
+
+/// atan2(cross, dot) < 0; atan2(-0, dot) is -pi for negative dot
+inline bool AngleIsNegative(double cross, double dot)
+{
+  return std::signbit(cross) && (cross != 0 || std::signbit(dot));
+}
+
+/// |atan2(cross, dot)| > pi/2; atan2(0, -0) is pi
+inline bool AngleExceeds90Degrees(double cross, double dot)
+{
+  return dot < 0 || (dot == 0 && cross == 0 && std::signbit(dot));
+}
+
+inline bool AngleIsNegative(const Point& origin, const Point& pa, const Point& pb)
+{
+  double cross, dot;
+  AngleCrossDot(origin, pa, pb, cross, dot);
+  return AngleIsNegative(cross, dot);
+}
+
+inline bool AngleExceeds90Degrees(const Point& origin, const Point& pa, const Point& pb)
+{
+  double cross, dot;
+  AngleCrossDot(origin, pa, pb, cross, dot);
+  return AngleExceeds90Degrees(cross, dot);
+}
+
+inline bool AngleExceedsPlus90DegreesOrIsNegative(const Point& origin, const Point& pa, const Point& pb)
+{
+  double cross, dot;
+  AngleCrossDot(origin, pa, pb, cross, dot);
+  // An angle below -90 degrees is negative as well
+  return AngleIsNegative(cross, dot) || AngleExceeds90Degrees(cross, dot);
+}
+
+/// atan2(y, x) >= 3pi/4, the direction of (x, y) is at least 135 degrees
+inline bool DirectionExceeds135Degrees(double x, double y)
+{
+  return !std::signbit(y) && (x < 0 || (x == 0 && y == 0 && std::signbit(x))) && y <= -x;
+}
+
+}//! namespace p2t;
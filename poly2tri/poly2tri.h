@@ -33,3 +33,4 @@
 
 #include "common/shapes.h"
 #include "sweep/cdt.h"
+#include "sweep/batch.h"
@@ -29,79 +29,231 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "advancing_front.h"
+#include "../common/stats.h"
 //#include <geometrix/utility/assert.hpp>
 
+#include <algorithm>
 #include <cassert>
 
 namespace p2t {
 
 AdvancingFront::AdvancingFront(Node& head, Node& tail)
+  : point_table_(16, nullptr), point_table_shift_(64 - 4)
+{
+  Reset(head, tail);
+}
+
+void AdvancingFront::Reset(Node& head, Node& tail)
 {
   head_ = &head;
   tail_ = &tail;
   search_node_ = &head;
+  root_ = &head;
+  size_ = 2;
+  seed_ = 2463534242u;
+  locate_steps_ = 0;
+  max_size_ = 2;
+  std::fill(point_table_.begin(), point_table_.end(), nullptr);
+
+  head.prev = nullptr;
+  head.next = &tail;
+  tail.prev = &head;
+  tail.next = nullptr;
+
+  head.parent = nullptr;
+  head.child[0] = nullptr;
+  head.child[1] = &tail;
+  tail.parent = &head;
+  tail.child[0] = tail.child[1] = nullptr;
+  head.priority = 0;
+  tail.priority = 0;
+
+  IndexPoint(&head);
+  IndexPoint(&tail);
 }
 
-Node* AdvancingFront::LocateNode(double x)
+void AdvancingFront::InsertAfter(Node& node, Node& new_node)
 {
-  Node* node = search_node_;
+  Node* next = node.next;
+  new_node.prev = &node;
+  new_node.next = next;
+  if (next) {
+    next->prev = &new_node;
+  }
+  node.next = &new_node;
 
-  if (x < node->value) {
-    while ((node = node->prev) != nullptr) {
-      if (x >= node->value) {
-        search_node_ = node;
-        return node;
-      }
-    }
+  // In-order position right after node: its right child slot if free, otherwise
+  // the left child slot of its successor, which is then the leftmost node of
+  // that right subtree.
+  new_node.child[0] = new_node.child[1] = nullptr;
+  if (!node.child[1]) {
+    node.child[1] = &new_node;
+    new_node.parent = &node;
   } else {
-    while ((node = node->next) != nullptr) {
-      if (x < node->value) {
-        search_node_ = node->prev;
-        return node->prev;
-      }
+    next->child[0] = &new_node;
+    new_node.parent = next;
+  }
+
+  // xorshift32
+  seed_ ^= seed_ << 13;
+  seed_ ^= seed_ >> 17;
+  seed_ ^= seed_ << 5;
+  new_node.priority = seed_;
+
+  // Restore the heap order on priorities
+  while (new_node.parent && new_node.parent->priority > new_node.priority) {
+    Rotate(&new_node);
+  }
+  ++size_;
+  POLY2TRI_STAT(max_size_ = std::max(max_size_, size_));
+
+  IndexPoint(&new_node);
+}
+
+void AdvancingFront::Remove(Node& node)
+{
+  if (node.prev) {
+    node.prev->next = node.next;
+  }
+  if (node.next) {
+    node.next->prev = node.prev;
+  }
+  if (search_node_ == &node) {
+    search_node_ = node.prev ? node.prev : node.next;
+  }
+
+  // Rotate the node down until it is a leaf, then cut it off
+  while (node.child[0] || node.child[1]) {
+    Node* child;
+    if (!node.child[0]) {
+      child = node.child[1];
+    } else if (!node.child[1]) {
+      child = node.child[0];
+    } else {
+      child = node.child[0]->priority < node.child[1]->priority ? node.child[0] : node.child[1];
     }
+    Rotate(child);
   }
-  return nullptr;
+  if (!node.parent) {
+    root_ = nullptr;
+  } else {
+    node.parent->child[node.parent->child[1] == &node] = nullptr;
+  }
+  node.parent = nullptr;
+  --size_;
+
+  UnindexPoint(&node);
+}
+
+// Rotate node above its parent
+void AdvancingFront::Rotate(Node* node)
+{
+  Node* parent = node->parent;
+  Node* grandparent = parent->parent;
+  const int side = parent->child[1] == node;
+
+  Node* inner = node->child[1 - side];
+  parent->child[side] = inner;
+  if (inner) {
+    inner->parent = parent;
+  }
+  node->child[1 - side] = parent;
+  parent->parent = node;
+
+  node->parent = grandparent;
+  if (!grandparent) {
+    root_ = node;
+  } else {
+    grandparent->child[grandparent->child[1] == parent] = node;
+  }
+}
+
+Node* AdvancingFront::LocateNode(double x)
+{
+  Node* node = FindSearchNode(x);
+  if (node) {
+    search_node_ = node;
+  }
+  return node;
 }
 
 Node* AdvancingFront::FindSearchNode(double x)
 {
-  (void)x; // suppress compiler warnings "unused parameter 'x'"
-  // TODO: implement BST index
-  return search_node_;
+  // The front is sorted on x, so this is the node a walk along the front
+  // would stop at
+  Node* found = nullptr;
+  Node* node = root_;
+  while (node) {
+    POLY2TRI_STAT(++locate_steps_);
+    if (x < node->value) {
+      node = node->child[0];
+    } else {
+      found = node;
+      node = node->child[1];
+    }
+  }
+  return found;
 }
 
 Node* AdvancingFront::LocatePoint(const Point* point)
 {
-  const double px = point->x;
-  Node* node = FindSearchNode(px);
-  const double nx = node->point->x;
-
-  if (px == nx) {
-    if (point != node->point) {
-      // We might have two nodes with same x value for a short time
-      if (point == node->prev->point) {
-        node = node->prev;
-      } else if (point == node->next->point) {
-        node = node->next;
-      } else {
-        //GEOMETRIX_ASSERT(0);
-      }
+  const size_t mask = point_table_.size() - 1;
+  for (size_t i = PointSlot(point); point_table_[i]; i = (i + 1) & mask) {
+    if (point_table_[i]->point == point) {
+      search_node_ = point_table_[i];
+      return search_node_;
     }
-  } else if (px < nx) {
-    while ((node = node->prev) != nullptr) {
-      if (point == node->point) {
-        break;
+  }
+  return nullptr;
+}
+
+// Fibonacci hashing of the point's address
+size_t AdvancingFront::PointSlot(const Point* point) const
+{
+  const std::uint64_t key = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(point));
+  return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> point_table_shift_);
+}
+
+void AdvancingFront::IndexPoint(Node* node)
+{
+  // Keep the load factor at or below one half
+  if (2 * size_ > point_table_.size()) {
+    std::vector<Node*> old(2 * point_table_.size(), nullptr);
+    old.swap(point_table_);
+    --point_table_shift_;
+    for (Node* n : old) {
+      if (n) {
+        IndexPoint(n);
       }
     }
-  } else {
-    while ((node = node->next) != nullptr) {
-      if (point == node->point)
-        break;
+  }
+  const size_t mask = point_table_.size() - 1;
+  size_t i = PointSlot(node->point);
+  while (point_table_[i]) {
+    i = (i + 1) & mask;
+  }
+  point_table_[i] = node;
+}
+
+void AdvancingFront::UnindexPoint(Node* node)
+{
+  const size_t mask = point_table_.size() - 1;
+  size_t i = PointSlot(node->point);
+  while (point_table_[i] != node) {
+    i = (i + 1) & mask;
+  }
+
+  // Shift later entries of the probe sequence back so that no lookup stops
+  // early at the hole
+  for (size_t j = (i + 1) & mask; point_table_[j]; j = (j + 1) & mask) {
+    const size_t home = PointSlot(point_table_[j]->point);
+    const bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+    if (!stays) {
+      point_table_[i] = point_table_[j];
+      i = j;
     }
   }
-  if(node) search_node_ = node;
-  return node;
+  point_table_[i] = nullptr;
 }
 
 AdvancingFront::~AdvancingFront()
@@ -34,6 +34,9 @@
 #include "../poly2tri_export.h"
 #include "../common/shapes.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace p2t {
 
 struct Node;
@@ -48,17 +51,30 @@ struct Node {
 
   double value;
 
-  Node(Point& p) : point(&p), triangle(NULL), next(NULL), prev(NULL), value(p.x)
+  // Search tree links, maintained by AdvancingFront. The tree's in-order
+  // sequence is the front itself.
+  Node* parent;
+  Node* child[2];
+  std::uint32_t priority;
+
+  Node(Point& p) : point(&p), triangle(NULL), next(NULL), prev(NULL), value(p.x),
+    parent(NULL), child{ NULL, NULL }, priority(0)
   {
   }
 
-  Node(Point& p, Triangle& t) : point(&p), triangle(&t), next(NULL), prev(NULL), value(p.x)
+  Node(Point& p, Triangle& t) : point(&p), triangle(&t), next(NULL), prev(NULL), value(p.x),
+    parent(NULL), child{ NULL, NULL }, priority(0)
   {
   }
 
 };
 
 // Advancing front
+//
+// The nodes form a doubly linked list ordered by x. They are also indexed by a
+// treap (a binary search tree balanced by random priorities) so that locating
+// a node takes O(log n) expected time however long the front grows, and by a
+// hash table keyed on the node's point so that LocatePoint is O(1).
 class POLY2TRI_API AdvancingFront {
 public:
 
@@ -66,6 +82,10 @@ AdvancingFront(Node& head, Node& tail);
 // Destructor
 ~AdvancingFront();
 
+/// Start over with a front of just head and tail, keeping the memory of the
+/// point table
+void Reset(Node& head, Node& tail);
+
 Node* head();
 void set_head(Node* node);
 Node* tail();
@@ -73,16 +93,53 @@ void set_tail(Node* node);
 Node* search();
 void set_search(Node* node);
 
+/// Link new_node into the front right after node
+void InsertAfter(Node& node, Node& new_node);
+
+/// Unlink node from the front. Its own prev and next are left untouched.
+void Remove(Node& node);
+
+/// Number of nodes on the front
+size_t size() const;
+
 /// Locate insertion point along advancing front
 Node* LocateNode(double x);
 
+/// The node holding point, or null if point is not on the front
 Node* LocatePoint(const Point* point);
 
+/// Search tree nodes visited by LocateNode, and the most nodes on the front
+/// at once, since the last Reset. Only kept with POLY2TRI_STATS.
+std::uint64_t locate_steps() const;
+size_t max_size() const;
+
+/// Bytes of the point table
+size_t reserved_bytes() const;
+
 private:
 
 Node* head_, *tail_, *search_node_;
 
+// Root of the search tree over the front
+Node* root_;
+size_t size_;
+// State of the generator for node priorities
+std::uint32_t seed_;
+std::uint64_t locate_steps_;
+size_t max_size_;
+
+// Open addressing table of the front nodes, keyed on their point's address
+std::vector<Node*> point_table_;
+int point_table_shift_;
+
+/// Last node with a value less than or equal to x
 Node* FindSearchNode(double x);
+
+void Rotate(Node* node);
+
+size_t PointSlot(const Point* point) const;
+void IndexPoint(Node* node);
+void UnindexPoint(Node* node);
 };
 
 inline Node* AdvancingFront::head()
@@ -103,6 +160,26 @@ inline void AdvancingFront::set_tail(Node* node)
   tail_ = node;
 }
 
+inline size_t AdvancingFront::size() const
+{
+  return size_;
+}
+
+inline std::uint64_t AdvancingFront::locate_steps() const
+{
+  return locate_steps_;
+}
+
+inline size_t AdvancingFront::max_size() const
+{
+  return max_size_;
+}
+
+inline size_t AdvancingFront::reserved_bytes() const
+{
+  return point_table_.capacity() * sizeof(Node*);
+}
+
 inline Node* AdvancingFront::search()
 {
   return search_node_;
@@ -0,0 +1,229 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2018, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "batch.h"
+#include "sweep.h"
+#include "sweep_context.h"
+
+#include <algorithm>
+
+namespace p2t {
+
+template <class Kernel>
+struct BasicBatchTriangulator<Kernel>::Worker {
+  SweepContext context;
+  BasicSweep<Kernel> sweep;
+
+  // Inputs [begin, end) are this worker's to take from the front, or for
+  // others to steal from the back
+  std::mutex mutex;
+  size_t begin;
+  size_t end;
+
+  Worker() : context(std::vector<Point*>()), begin(0), end(0)
+  {
+  }
+
+  void Triangulate(const BatchInput& input, BatchResult& result, size_t index)
+  {
+    TraceScope trace(sweep.tracer(), TracePhase::kBatchInput, index);
+    result.triangles.clear();
+    result.error = nullptr;
+    try {
+      context.Reset(input.polyline);
+      for (auto& hole : input.holes) {
+        context.AddHole(hole);
+      }
+      for (auto p : input.steiner) {
+        context.AddPoint(p);
+      }
+      sweep.Triangulate(context);
+      for (auto t : context.GetTriangles()) {
+        result.triangles.push_back(t->GetPoint(0));
+        result.triangles.push_back(t->GetPoint(1));
+        result.triangles.push_back(t->GetPoint(2));
+      }
+    } catch (...) {
+      result.triangles.clear();
+      result.error = std::current_exception();
+    }
+  }
+};
+
+template <class Kernel>
+BasicBatchTriangulator<Kernel>::BasicBatchTriangulator(unsigned num_threads)
+  : generation_(0), running_(0), stop_(false), inputs_(nullptr), results_(nullptr)
+{
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (unsigned i = 0; i < num_threads; ++i) {
+    workers_.emplace_back(new Worker);
+  }
+  for (unsigned i = 1; i < num_threads; ++i) {
+    threads_.emplace_back(&BasicBatchTriangulator::Run, this, i);
+  }
+}
+
+template <class Kernel>
+BasicBatchTriangulator<Kernel>::~BasicBatchTriangulator()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+template <class Kernel>
+void BasicBatchTriangulator<Kernel>::Triangulate(const std::vector<BatchInput>& inputs,
+                                                 std::vector<BatchResult>& results)
+{
+  results.resize(inputs.size());
+  if (inputs.empty()) {
+    return;
+  }
+
+  const size_t n = inputs.size();
+  const size_t num_workers = workers_.size();
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers_[i]->begin = n * i / num_workers;
+    workers_[i]->end = n * (i + 1) / num_workers;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    inputs_ = &inputs;
+    results_ = &results;
+    running_ = static_cast<unsigned>(threads_.size());
+    ++generation_;
+  }
+  start_.notify_all();
+
+  Work(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return running_ == 0; });
+  inputs_ = nullptr;
+  results_ = nullptr;
+}
+
+template <class Kernel>
+void BasicBatchTriangulator<Kernel>::SetTracer(Tracer* tracer)
+{
+  for (auto& worker : workers_) {
+    worker->sweep.set_tracer(tracer);
+  }
+}
+
+template <class Kernel>
+void BasicBatchTriangulator<Kernel>::Run(unsigned index)
+{
+  size_t generation = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [&] { return stop_ || generation_ != generation; });
+      if (stop_) {
+        return;
+      }
+      generation = generation_;
+    }
+
+    Work(index);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--running_ == 0) {
+      done_.notify_all();
+    }
+  }
+}
+
+template <class Kernel>
+void BasicBatchTriangulator<Kernel>::Work(unsigned index)
+{
+  Worker& worker = *workers_[index];
+  for (;;) {
+    size_t item = 0;
+    bool found = false;
+    {
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      if (worker.begin < worker.end) {
+        item = worker.begin++;
+        found = true;
+      }
+    }
+    if (found) {
+      worker.Triangulate((*inputs_)[item], (*results_)[item], item);
+    } else if (!Steal(index)) {
+      return;
+    }
+  }
+}
+
+template <class Kernel>
+bool BasicBatchTriangulator<Kernel>::Steal(unsigned index)
+{
+  const size_t num_workers = workers_.size();
+  for (size_t i = 1; i < num_workers; ++i) {
+    Worker& victim = *workers_[(index + i) % num_workers];
+    size_t begin, end;
+    {
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (victim.begin >= victim.end) {
+        continue;
+      }
+      // Take the back half, rounded up so that a last input is taken too
+      end = victim.end;
+      begin = victim.begin + (victim.end - victim.begin) / 2;
+      victim.end = begin;
+    }
+    // Nobody steals from this worker meanwhile, its range is empty
+    Worker& thief = *workers_[index];
+    std::lock_guard<std::mutex> lock(thief.mutex);
+    thief.begin = begin;
+    thief.end = end;
+    return true;
+  }
+  return false;
+}
+
+template class BasicBatchTriangulator<InexactKernel>;
+#ifdef POLY2TRI_USE_EXACT
+template class BasicBatchTriangulator<FilteredExactKernel>;
+#endif
+#ifdef __SIZEOF_INT128__
+template class BasicBatchTriangulator<IntegerExactKernel>;
+#endif
+
+} // namespace p2t
@@ -0,0 +1,140 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2018, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "../poly2tri_export.h"
+#include "../common/shapes.h"
+#include "../common/trace.h"
+#include "../common/utils.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace p2t {
+
+/**
+ * One polygon of a batch with its holes and Steiner points. Triangulating
+ * only reads the points, so inputs may share them.
+ */
+struct POLY2TRI_API BatchInput {
+  std::vector<Point*> polyline;
+  std::vector<std::vector<Point*>> holes;
+  std::vector<Point*> steiner;
+};
+
+/// Triangulation of one BatchInput
+struct POLY2TRI_API BatchResult {
+  /// The triangles inside the polygon, three points each
+  std::vector<Point*> triangles;
+  /// What the triangulation threw, if it failed; triangles is empty then
+  std::exception_ptr error;
+};
+
+/**
+ * Triangulates many independent polygons on a pool of threads. Every thread
+ * keeps its own SweepContext and sweep from one input to the next. The
+ * inputs are split evenly between the threads up front, and a thread that
+ * runs out of inputs steals half of what another has left.
+ */
+template <class Kernel>
+class POLY2TRI_API BasicBatchTriangulator
+{
+public:
+
+  /**
+   * Starts the pool. The thread calling Triangulate works as one of the
+   * threads, so num_threads - 1 are started.
+   *
+   * @param num_threads - 0 picks one per hardware thread
+   */
+  explicit BasicBatchTriangulator(unsigned num_threads = 0);
+
+  ~BasicBatchTriangulator();
+
+  BasicBatchTriangulator(const BasicBatchTriangulator&) = delete;
+  BasicBatchTriangulator& operator=(const BasicBatchTriangulator&) = delete;
+
+  unsigned thread_count() const { return static_cast<unsigned>(workers_.size()); }
+
+  /**
+   * Triangulates every input into the result at the same index. results is
+   * resized to match inputs; the storage of results already there is reused.
+   * A failed input does not stop the others, its exception is kept in its
+   * result.
+   */
+  void Triangulate(const std::vector<BatchInput>& inputs, std::vector<BatchResult>& results);
+
+  /**
+   * Report the phases of the following batches to tracer, each input in a
+   * kBatchInput span, or stop reporting them if it is null. The tracer is
+   * called from all threads of the pool at once; spans nest per thread.
+   */
+  void SetTracer(Tracer* tracer);
+
+private:
+
+  struct Worker;
+
+  void Run(unsigned index);
+  void Work(unsigned index);
+  bool Steal(unsigned index);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  size_t generation_;
+  unsigned running_;
+  bool stop_;
+
+  const std::vector<BatchInput>* inputs_;
+  std::vector<BatchResult>* results_;
+};
+
+extern template class BasicBatchTriangulator<InexactKernel>;
+#ifdef POLY2TRI_USE_EXACT
+extern template class BasicBatchTriangulator<FilteredExactKernel>;
+#endif
+#ifdef __SIZEOF_INT128__
+extern template class BasicBatchTriangulator<IntegerExactKernel>;
+#endif
+
+typedef BasicBatchTriangulator<DefaultKernel> BatchTriangulator;
+
+}
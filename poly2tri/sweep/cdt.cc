@@ -30,42 +30,457 @@
  */
 #include "cdt.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <thread>
+
 namespace p2t {
 
-CDT::CDT(const std::vector<Point*>& polyline)
+namespace {
+
+// Splits 0 .. n - 1 into num_threads runs and calls f(thread, begin, end)
+// for each on its own thread. What a run throws is rethrown here once all
+// are done, the first run's first.
+template <class F>
+void ForEachRun(unsigned num_threads, size_t n, F f)
+{
+  std::vector<std::exception_ptr> errors(num_threads);
+  const auto run = [&f, &errors, num_threads, n](unsigned t) {
+    try {
+      f(t, n * t / num_threads, n * (t + 1) / num_threads);
+    } catch (...) {
+      errors[t] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned t = 1; t < num_threads; ++t) {
+    threads.emplace_back(run, t);
+  }
+  run(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+} // namespace
+
+template <class Kernel>
+BasicCDT<Kernel>::BasicCDT(const std::vector<Point*>& polyline)
+  : num_points_(0), point_order_shift_(0), point_order_valid_(false), streamed_(false)
 {
   sweep_context_ = new SweepContext(polyline);
-  sweep_ = new Sweep;
+  sweep_ = new BasicSweep<Kernel>;
+}
+
+template <class Kernel>
+BasicCDT<Kernel>::BasicCDT(const CoordinateBuffer<double>& input)
+  : num_points_(0), point_order_shift_(0), point_order_valid_(false), streamed_(false)
+{
+  sweep_context_ = new SweepContext(std::vector<Point*>());
+  sweep_ = new BasicSweep<Kernel>;
+  Load(input);
+}
+
+template <class Kernel>
+BasicCDT<Kernel>::BasicCDT(const CoordinateBuffer<float>& input)
+  : num_points_(0), point_order_shift_(0), point_order_valid_(false), streamed_(false)
+{
+  sweep_context_ = new SweepContext(std::vector<Point*>());
+  sweep_ = new BasicSweep<Kernel>;
+  Load(input);
+}
+
+template <class Kernel>
+void BasicCDT<Kernel>::Reset(const std::vector<Point*>& polyline)
+{
+  num_points_ = 0;
+  streamed_ = false;
+  sweep_context_->Reset(polyline);
+}
+
+template <class Kernel>
+void BasicCDT<Kernel>::Reset(const CoordinateBuffer<double>& input)
+{
+  Load(input);
+}
+
+template <class Kernel>
+void BasicCDT<Kernel>::Reset(const CoordinateBuffer<float>& input)
+{
+  Load(input);
+}
+
+template <class Kernel>
+template <class T>
+void BasicCDT<Kernel>::Load(const CoordinateBuffer<T>& input)
+{
+  // Ring r runs from its offset to the next; the outline starts at 0
+  auto ring_begin = [&input](size_t r) { return r == 0 ? 0 : input.hole_offsets[r - 1]; };
+  auto ring_end = [&input](size_t r) {
+    return r < input.num_holes ? input.hole_offsets[r] : input.steiner_begin;
+  };
+  if (input.steiner_begin > input.num_points) {
+    throw poly2tri_exception("poly2tri: Steiner points begin past the last point");
+  }
+  for (size_t r = 0; r <= input.num_holes; ++r) {
+    if (ring_end(r) < ring_begin(r) + 3) {
+      throw poly2tri_exception("poly2tri: ring with less than three points");
+    }
+  }
+
+  points_.resize(input.num_points);
+  num_points_ = input.num_points;
+  streamed_ = false;
+  for (size_t i = 0; i < input.num_points; ++i) {
+    points_[i].set(input.coords[2 * i], input.coords[2 * i + 1]);
+  }
+
+  for (size_t r = 0; r <= input.num_holes; ++r) {
+    ring_.clear();
+    for (size_t i = ring_begin(r); i < ring_end(r); ++i) {
+      ring_.push_back(&points_[i]);
+    }
+    if (r == 0) {
+      sweep_context_->Reset(ring_);
+    } else {
+      sweep_context_->AddHole(ring_);
+    }
+  }
+  for (size_t i = input.steiner_begin; i < input.num_points; ++i) {
+    sweep_context_->AddPoint(&points_[i]);
+  }
 }
 
-void CDT::AddHole(const std::vector<Point*>& polyline)
+template <class Kernel>
+void BasicCDT<Kernel>::AddHole(const std::vector<Point*>& polyline)
 {
   sweep_context_->AddHole(polyline);
 }
 
-void CDT::AddPoint(Point* point) {
+template <class Kernel>
+void BasicCDT<Kernel>::AddPoint(Point* point) {
   sweep_context_->AddPoint(point);
 }
 
-void CDT::Triangulate()
+template <class Kernel>
+void BasicCDT<Kernel>::Triangulate()
 {
+  point_order_valid_ = false;
+  streamed_ = false;
   sweep_->Triangulate(*sweep_context_);
 }
 
-std::vector<p2t::Triangle*> CDT::GetTriangles()
+template <class Kernel>
+void BasicCDT<Kernel>::Triangulate(TriangleSink& sink)
+{
+  point_order_valid_ = false;
+  streamed_ = true;
+  sweep_context_->set_sink(&sink);
+  try {
+    sweep_->Triangulate(*sweep_context_);
+  } catch (...) {
+    sweep_context_->set_sink(nullptr);
+    throw;
+  }
+  sweep_context_->set_sink(nullptr);
+}
+
+template <class Kernel>
+const std::vector<p2t::Triangle*>& BasicCDT<Kernel>::GetTriangles()
 {
   return sweep_context_->GetTriangles();
 }
 
-std::list<p2t::Triangle*> CDT::GetMap()
+template <class Kernel>
+size_t BasicCDT<Kernel>::GetPointIndex(const Point* point)
+{
+  // Compared as addresses, as the point may be anywhere
+  const std::less<const Point*> less;
+  if (num_points_ > 0) {
+    if (less(point, points_.data()) || !less(point, points_.data() + num_points_)) {
+      throw poly2tri_exception("poly2tri: point is not from the input");
+    }
+    return static_cast<size_t>(point - points_.data());
+  }
+
+  IndexPoints();
+  for (size_t s = PointOrderSlot(point); point_order_[s].first;
+       s = (s + 1) & (point_order_.size() - 1)) {
+    if (point_order_[s].first == point) {
+      return point_order_[s].second;
+    }
+  }
+  throw poly2tri_exception("poly2tri: point is not from the input");
+}
+
+template <class Kernel>
+size_t BasicCDT<Kernel>::PointOrderSlot(const Point* point) const
+{
+  return static_cast<size_t>((reinterpret_cast<std::uintptr_t>(point) * 0x9E3779B97F4A7C15ull) >>
+                             point_order_shift_);
+}
+
+template <class Kernel>
+void BasicCDT<Kernel>::IndexPoints()
+{
+  if (num_points_ > 0 || point_order_valid_) {
+    return;
+  }
+  // Open addressing table keyed on the point's address, like the point
+  // table of AdvancingFront
+  const std::vector<Point*>& input = sweep_context_->GetInputPoints();
+  size_t capacity = 16;
+  point_order_shift_ = 64 - 4;
+  while (capacity < 2 * input.size()) {
+    capacity *= 2;
+    --point_order_shift_;
+  }
+  point_order_.assign(capacity, std::make_pair(nullptr, size_t(0)));
+  for (size_t i = 0; i < input.size(); ++i) {
+    size_t s = PointOrderSlot(input[i]);
+    while (point_order_[s].first) {
+      s = (s + 1) & (capacity - 1);
+    }
+    point_order_[s] = std::make_pair(input[i], i);
+  }
+  point_order_valid_ = true;
+}
+
+template <class Kernel>
+void BasicCDT<Kernel>::GetTriangleIndices(std::vector<size_t>& indices)
+{
+  indices.resize(3 * sweep_context_->GetTriangles().size());
+  ExportTriangles(indices.data());
+}
+
+template <class Kernel>
+void BasicCDT<Kernel>::ExportMesh(CompactMesh& mesh)
+{
+  const std::vector<Triangle*>& interior = sweep_context_->GetTriangles();
+  if (interior.size() > kNoCorner / 3) {
+    throw poly2tri_exception("poly2tri: too many triangles for a compact mesh");
+  }
+  mesh.Resize(interior.size());
+  ExportTriangles(mesh.vertices_.data(), mesh.opposite_.data(), mesh.constrained_.data());
+
+  // Turn the neighbor of each edge into the corner of the neighbor facing it
+  for (size_t c = 0; c < mesh.opposite_.size(); ++c) {
+    const std::uint32_t k = mesh.opposite_[c];
+    if (k != kNoCorner) {
+      Triangle& t = *interior[c / 3];
+      Triangle& neighbor = *interior[k];
+      const int j = neighbor.Index(neighbor.OppositePoint(t, *t.GetPoint(static_cast<int>(c % 3))));
+      mesh.opposite_[c] = 3 * k + static_cast<std::uint32_t>(j);
+    }
+  }
+}
+
+template <class Kernel>
+MeshReport BasicCDT<Kernel>::Validate(unsigned num_threads)
+{
+  if (streamed_) {
+    throw poly2tri_exception("poly2tri: a streamed triangulation cannot be validated");
+  }
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  const std::vector<Triangle*>& triangles = sweep_context_->GetTriangles();
+  std::vector<MeshReport> reports(num_threads);
+
+  // Each edge is compared with its neighbor's from both sides, and tested
+  // from the side earlier in GetTriangles. It is only reported when the
+  // other diagonal of the pair would pass, as Incircle may count points on
+  // the circle as in it.
+  ForEachRun(num_threads, triangles.size(), [&](unsigned thread, size_t begin, size_t end) {
+    MeshReport& report = reports[thread];
+    for (size_t k = begin; k < end; ++k) {
+      Triangle& t = *triangles[k];
+      const bool ccw = Orient2d<Kernel>(*t.GetPoint(0), *t.GetPoint(1), *t.GetPoint(2)) == CCW;
+      report.not_ccw += !ccw;
+      for (int i = 0; i < 3; ++i) {
+        Point* a = t.GetPoint((i + 1) % 3);
+        Point* b = t.GetPoint((i + 2) % 3);
+        Triangle* neighbor = t.GetNeighbor(i);
+        if (!neighbor || !neighbor->IsInterior()) {
+          report.bad_constraints += !t.constrained_edge[i];
+          continue;
+        }
+        const int j = neighbor->EdgeIndex(a, b);
+        if (j < 0 || neighbor->GetNeighbor(j) != &t) {
+          ++report.bad_neighbors;
+        } else if (neighbor->constrained_edge[j] != t.constrained_edge[i]) {
+          ++report.bad_constraints;
+        } else if (neighbor->InteriorIndex() > k && ccw && !t.constrained_edge[i] &&
+                   Incircle<Kernel>(*t.GetPoint(i), *a, *b, *neighbor->GetPoint(j)) &&
+                   !Incircle<Kernel>(*a, *neighbor->GetPoint(j), *t.GetPoint(i), *b)) {
+          ++report.not_delaunay;
+        }
+      }
+    }
+  });
+
+  // The far points of the constrained edges from each input point. The
+  // table GetPointIndex reads is built here, before the threads below read
+  // it too.
+  IndexPoints();
+  const size_t num_points = num_points_ > 0 ? num_points_ : sweep_context_->GetInputPoints().size();
+  std::vector<size_t> offsets(num_points + 1, 0);
+  for (Triangle* t : triangles) {
+    for (int i = 0; i < 3; ++i) {
+      if (t->constrained_edge[i]) {
+        ++offsets[GetPointIndex(t->GetPoint((i + 1) % 3)) + 1];
+        ++offsets[GetPointIndex(t->GetPoint((i + 2) % 3)) + 1];
+      }
+    }
+  }
+  for (size_t i = 1; i < offsets.size(); ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  std::vector<Point*> ends(offsets.back());
+  std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+  for (Triangle* t : triangles) {
+    for (int i = 0; i < 3; ++i) {
+      if (t->constrained_edge[i]) {
+        Point* a = t->GetPoint((i + 1) % 3);
+        Point* b = t->GetPoint((i + 2) % 3);
+        ends[cursor[GetPointIndex(a)]++] = b;
+        ends[cursor[GetPointIndex(b)]++] = a;
+      }
+    }
+  }
+
+  // Follow each polygon edge from its lower point, through points on it
+  const std::vector<Edge*>& edges = sweep_context_->edge_list;
+  ForEachRun(num_threads, edges.size(), [&](unsigned thread, size_t begin, size_t end) {
+    for (size_t e = begin; e < end; ++e) {
+      const Point& p = *edges[e]->p;
+      Point* q = edges[e]->q;
+      const double dx = q->x - p.x, dy = q->y - p.y;
+      for (const Point* at = &p; at != q;) {
+        const size_t index = GetPointIndex(at);
+        const Point* next = nullptr;
+        for (size_t k = offsets[index]; k < offsets[index + 1] && next != q; ++k) {
+          const Point& r = *ends[k];
+          if (&r == q || ((r.x - at->x) * dx + (r.y - at->y) * dy > 0 &&
+                          (q->x - r.x) * dx + (q->y - r.y) * dy > 0 &&
+                          Orient2d<Kernel>(p, *q, r) == COLLINEAR)) {
+            next = &r;
+          }
+        }
+        if (!next) {
+          ++reports[thread].missing_edges;
+          break;
+        }
+        at = next;
+      }
+    }
+  });
+
+  MeshReport report;
+  for (auto& r : reports) {
+    report += r;
+  }
+  return report;
+}
+
+template <class Kernel>
+void BasicCDT<Kernel>::CheckIndexRange(size_t max_index)
+{
+  const size_t num_points = num_points_ > 0 ? num_points_ : sweep_context_->GetInputPoints().size();
+  const size_t num_triangles = sweep_context_->GetTriangles().size();
+  // The largest index is kept free to mark missing neighbors, and triangles
+  // know their position as 32 bit integers
+  if (num_points > max_index || num_triangles >= max_index ||
+      num_triangles > std::numeric_limits<std::uint32_t>::max()) {
+    throw poly2tri_exception("poly2tri: too many points or triangles for the index type");
+  }
+}
+
+template <class Kernel>
+const TriangleMap& BasicCDT<Kernel>::GetMap() const
 {
   return sweep_context_->GetMap();
 }
 
-CDT::~CDT()
+template <class Kernel>
+size_t BasicCDT<Kernel>::GetFlipCount() const
+{
+  return sweep_->flip_count();
+}
+
+template <class Kernel>
+const TriangulationStats& BasicCDT<Kernel>::GetStats() const
+{
+  return sweep_->stats();
+}
+
+template <class Kernel>
+void BasicCDT<Kernel>::SetTracer(Tracer* tracer)
+{
+  sweep_->set_tracer(tracer);
+}
+
+template <class Kernel>
+MemoryReport BasicCDT<Kernel>::GetMemoryUsage() const
+{
+  MemoryReport report;
+  sweep_context_->AddMemoryUsage(report);
+  sweep_->AddMemoryUsage(report);
+  report.points.Add(points_);
+  report.points.AddBuffer(ring_);
+  report.points.AddBuffer(point_order_);
+  return report;
+}
+
+template <class Kernel>
+BasicCDT<Kernel>::~BasicCDT()
 {
   delete sweep_context_;
   delete sweep_;
 }
 
+namespace {
+
+// Bytes EstimatePeakMemory allows for the fixed costs of a triangulation
+const double kFixedBytes = 4 * 1024;
+
+} // namespace
+
+size_t EstimatePeakMemory(size_t num_vertices, size_t num_holes, size_t num_steiner)
+{
+  const double n = static_cast<double>(num_vertices + num_steiner);
+  // Every triangle of the points and the two sentinels, those outside the
+  // polygon too, and the list of those inside, which a hole adds two to
+  double bytes = 2 * (n + 2) * sizeof(Triangle) + (n + 2 * num_holes) * sizeof(Triangle*);
+  // The sorted and input points, the rank of each, the edge table offsets,
+  // the sort keys with their buffer, and the worklist of MeshClean, which
+  // holds up to two triangles a point and grows by doubling
+  bytes += n * (2 * sizeof(Point*) + 2 * sizeof(size_t) + 2 * (2 * sizeof(std::uint64_t) + sizeof(size_t)) +
+                4 * sizeof(Triangle*));
+  // An edge per vertex, in the edge list and the table by point
+  bytes += num_vertices * (sizeof(Edge) + 2 * sizeof(Edge*) + sizeof(size_t));
+  // The front and its point table. Half the vertices on it at once covers
+  // combs, whose teeth all reach the front.
+  bytes += (num_vertices / 2.0 + 8 * std::sqrt(n)) * (sizeof(Node) + 2 * sizeof(Node*));
+  // A tenth more for buffers that grow by doubling past what they hold, and
+  // the storage that any triangulation starts with
+  return static_cast<size_t>(1.1 * bytes + kFixedBytes);
+}
+
+template class BasicCDT<InexactKernel>;
+#ifdef POLY2TRI_USE_EXACT
+template class BasicCDT<FilteredExactKernel>;
+#endif
+#ifdef __SIZEOF_INT128__
+template class BasicCDT<IntegerExactKernel>;
+#endif
+
 } // namespace p2t
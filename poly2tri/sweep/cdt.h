@@ -36,8 +36,13 @@
 #include "sweep_context.h"
 #include "sweep.h"
 
+#include "../common/compact_mesh.h"
 #include "../common/dll_symbol.h"
 
+#include <cstdint>
+#include <limits>
+#include <utility>
+
 /**
  *
  * @author Mason Green <mason.green@gmail.com>
@@ -46,7 +51,65 @@
 
 namespace p2t {
 
-class POLY2TRI_API CDT
+/**
+ * Polygon in caller owned arrays of coordinates, x0 y0 x1 y1 ... for the
+ * points numbered 0 to num_points - 1. The outline runs from point 0 to the
+ * first hole, hole i from hole_offsets[i] to the next hole, and the last
+ * ring ends at steiner_begin. The points from there on are Steiner points.
+ */
+template <class T>
+struct CoordinateBuffer {
+  const T* coords;
+  size_t num_points;
+  const size_t* hole_offsets;
+  size_t num_holes;
+  size_t steiner_begin;
+};
+
+/**
+ * What BasicCDT::Validate found wrong with a triangulation. The counts are
+ * of triangle edges, but for not_ccw, of triangles, and missing_edges, of
+ * edges of the polygon and its holes.
+ */
+struct MeshReport {
+  /// Triangles not in counterclockwise order
+  size_t not_ccw = 0;
+  /// Edges whose neighbor does not share them or does not point back
+  size_t bad_neighbors = 0;
+  /// Edges constrained on one side only, or ending the mesh unconstrained
+  size_t bad_constraints = 0;
+  /// Unconstrained edges with the neighbor's far point in the circumcircle
+  size_t not_delaunay = 0;
+  /// Polygon and hole edges not made of constrained edges
+  size_t missing_edges = 0;
+
+  bool ok() const
+  {
+    return not_ccw == 0 && bad_neighbors == 0 && bad_constraints == 0 && not_delaunay == 0 &&
+           missing_edges == 0;
+  }
+
+  MeshReport& operator+=(const MeshReport& other)
+  {
+    not_ccw += other.not_ccw;
+    bad_neighbors += other.bad_neighbors;
+    bad_constraints += other.bad_constraints;
+    not_delaunay += other.not_delaunay;
+    missing_edges += other.missing_edges;
+    return *this;
+  }
+};
+
+/**
+ * Constrained Delaunay triangulation with the predicates of Kernel, see
+ * BasicSweep. CDT uses the default kernel.
+ *
+ * A CDT never writes to the points it is given, so CDTs on different
+ * threads may triangulate the same points at once, for instance one
+ * outline with different holes.
+ */
+template <class Kernel>
+class POLY2TRI_API BasicCDT
 {
 public:
 
@@ -55,12 +118,41 @@ public:
    *
    * @param polyline
    */
-  CDT(const std::vector<Point*>& polyline);
+  BasicCDT(const std::vector<Point*>& polyline);
+
+  /**
+   * Constructor - polygon, holes and Steiner points from coordinate arrays.
+   * The CDT keeps its points in one block instead of one allocation each;
+   * the arrays are not used after construction.
+   *
+   * @param input
+   */
+  explicit BasicCDT(const CoordinateBuffer<double>& input);
+  explicit BasicCDT(const CoordinateBuffer<float>& input);
 
    /**
    * Destructor - clean up memory
    */
-  ~CDT();
+  ~BasicCDT();
+
+  /**
+   * Start over with a new polyline, as if the CDT was constructed with it.
+   * The memory of the previous triangulation is kept for the next, so
+   * triangulating polygons of similar sizes one after another with the same
+   * CDT does not allocate. Triangles from before are no longer valid.
+   *
+   * @param polyline
+   */
+  void Reset(const std::vector<Point*>& polyline);
+
+  /**
+   * Start over with a polygon from coordinate arrays, see Reset above. The
+   * block of points is reused too.
+   *
+   * @param input
+   */
+  void Reset(const CoordinateBuffer<double>& input);
+  void Reset(const CoordinateBuffer<float>& input);
 
   /**
    * Add a hole
@@ -82,14 +174,106 @@ public:
   void Triangulate();
 
   /**
-   * Get CDT triangles
+   * Triangulate, passing each interior triangle to sink as soon as the sweep
+   * is done with it rather than collecting them into GetTriangles, which
+   * stays empty. The triangles behind the sweep are released as it goes, so
+   * the mesh is never held whole and can be consumed while it is built.
+   *
+   * @param sink - see TriangleSink for how long a triangle stays valid
+   */
+  void Triangulate(TriangleSink& sink);
+
+  /**
+   * Get CDT triangles. They are owned by the CDT.
+   */
+  const std::vector<Triangle*>& GetTriangles();
+
+  /**
+   * Index of a point of the input: its position in the coordinate arrays for
+   * a CDT built from them, otherwise its position among the polyline, holes
+   * and Steiner points in the order they were added, which is known once
+   * triangulated. Throws for other points.
+   */
+  size_t GetPointIndex(const Point* point);
+
+  /**
+   * Get CDT triangles as indices of their points, three per triangle, see
+   * GetPointIndex
+   */
+  void GetTriangleIndices(std::vector<size_t>& indices);
+
+  /**
+   * Write the triangles of GetTriangles into caller owned buffers, ready to
+   * upload as they are:
+   *
+   * @param triangles - indices of the points of each triangle, see
+   *                    GetPointIndex, 3 * GetTriangles().size() of them
+   * @param neighbors - if given, for each edge of each triangle, the position
+   *                    in GetTriangles of the triangle across it, or the
+   *                    largest Index if there is none inside the polygon.
+   *                    Edge i is the edge opposite point i.
+   * @param constrained - if given, one mask per triangle with bit i set if
+   *                      edge i is constrained
+   *
+   * Throws if the points or triangles are too many for Index.
+   */
+  template <class Index>
+  void ExportTriangles(Index* triangles, Index* neighbors = nullptr,
+                       std::uint8_t* constrained = nullptr);
+
+  /**
+   * Copy the triangles of GetTriangles into a corner table, triangle k of
+   * the mesh being GetTriangles()[k], with points numbered as by
+   * GetPointIndex. The mesh keeps its memory from one export to the next.
+   * Throws if the points or corners do not fit 32 bits.
+   *
+   * @param mesh
+   */
+  void ExportMesh(CompactMesh& mesh);
+
+  /**
+   * Check the triangles of GetTriangles in time linear in their number:
+   * each is counterclockwise, its neighbors share its edges and point back,
+   * the mesh ends on constrained edges, every other edge is locally
+   * Delaunay, and each polygon and hole edge is there, constrained, whole
+   * or split at points lying on it. The predicates are those of Kernel.
+   * Throws after Triangulate with a sink, which leaves no triangles to check.
+   *
+   * @param num_threads - threads to split the work over, 0 for one per core
+   */
+  MeshReport Validate(unsigned num_threads = 1);
+
+  /**
+   * Get triangle map, every triangle including those outside the polygon.
+   * Iterate it in place; it is owned by the CDT.
+   */
+  const TriangleMap& GetMap() const;
+
+  /**
+   * Number of edge flips done by legalization during Triangulate
+   */
+  size_t GetFlipCount() const;
+
+  /**
+   * Counters and phase timers of the last Triangulate. Most are only kept in
+   * builds with POLY2TRI_STATS, see TriangulationStats.
+   */
+  const TriangulationStats& GetStats() const;
+
+  /**
+   * Report the phases of the following calls of Triangulate to tracer, or
+   * stop reporting them if it is null. The tracer is not owned by the CDT
+   * and must outlive its use.
    */
-  std::vector<Triangle*> GetTriangles();
+  void SetTracer(Tracer* tracer);
 
   /**
-   * Get triangle map
+   * Memory held by the CDT, by kind of structure: in use at the end of the
+   * last Triangulate, the most in use during it, and obtained from the
+   * allocator. Also callable during Triangulate, from a Tracer or a
+   * TriangleSink. See EstimatePeakMemory to plan ahead.
    */
-  std::list<Triangle*> GetMap();
+  MemoryReport GetMemoryUsage() const;
   
   //! Access the points.
   std::vector< Point* >& GetPoints() { return sweep_context_->GetPoints(); }
@@ -100,9 +284,88 @@ public:
    * Internals
    */
 
+  template <class T>
+  void Load(const CoordinateBuffer<T>& input);
+
+  /// Throw if there are points or triangles past max_index
+  void CheckIndexRange(size_t max_index);
+
+  /// Build point_order_ for Point pointer input, if not built yet
+  void IndexPoints();
+  size_t PointOrderSlot(const Point* point) const;
+
   SweepContext* sweep_context_;
-  Sweep* sweep_;
+  BasicSweep<Kernel>* sweep_;
+
+  // Points of coordinate array input, num_points_ of them, and a ring of them
+  // at a time
+  std::vector<Point> points_;
+  size_t num_points_;
+  std::vector<Point*> ring_;
+
+  // Points of Point pointer input with their input index, hashed by address,
+  // built on demand after each triangulation
+  std::vector<std::pair<const Point*, size_t>> point_order_;
+  int point_order_shift_;
+  bool point_order_valid_;
+  // Whether the last Triangulate passed its triangles to a sink
+  bool streamed_;
 
 };
 
+/**
+ * Upper bound on the peak of MemoryReport::total for triangulating, by a
+ * CDT built from Point pointers, a polygon with num_vertices points on its
+ * outline and holes together, num_holes holes and num_steiner Steiner
+ * points, for admission control. It is about a fifth over the peak for
+ * large inputs, and more for small ones, as it includes fixed costs.
+ *
+ * The bound takes the advancing front to hold at most half the vertices and
+ * a multiple of the square root of the points at once. That holds for
+ * combs, whose teeth all reach the front, but not for inputs with long rows
+ * of Steiner points at one height. A CDT built from coordinate arrays also
+ * holds a Point for each point. Reserved memory may exceed the peak by the
+ * rounding up of storage blocks.
+ */
+POLY2TRI_API size_t EstimatePeakMemory(size_t num_vertices, size_t num_holes, size_t num_steiner);
+
+extern template class BasicCDT<InexactKernel>;
+#ifdef POLY2TRI_USE_EXACT
+extern template class BasicCDT<FilteredExactKernel>;
+#endif
+#ifdef __SIZEOF_INT128__
+extern template class BasicCDT<IntegerExactKernel>;
+#endif
+
+template <class Kernel>
+template <class Index>
+void BasicCDT<Kernel>::ExportTriangles(Index* triangles, Index* neighbors,
+                                       std::uint8_t* constrained)
+{
+  const Index none = std::numeric_limits<Index>::max();
+  CheckIndexRange(static_cast<size_t>(none));
+  const std::vector<Triangle*>& interior = sweep_context_->GetTriangles();
+  for (size_t k = 0; k < interior.size(); ++k) {
+    Triangle& t = *interior[k];
+    std::uint8_t mask = 0;
+    for (int i = 0; i < 3; ++i) {
+      triangles[3 * k + i] = static_cast<Index>(GetPointIndex(t.GetPoint(i)));
+      if (neighbors) {
+        Triangle* neighbor = t.GetNeighbor(i);
+        neighbors[3 * k + i] = neighbor && neighbor->IsInterior()
+                                 ? static_cast<Index>(neighbor->InteriorIndex())
+                                 : none;
+      }
+      if (t.constrained_edge[i]) {
+        mask |= static_cast<std::uint8_t>(1 << i);
+      }
+    }
+    if (constrained) {
+      constrained[k] = mask;
+    }
+  }
+}
+
+typedef BasicCDT<DefaultKernel> CDT;
+
 }
@@ -0,0 +1,247 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2018, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "point_sort.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+namespace p2t {
+
+namespace {
+
+// Below this many points a merge sort is faster than setting up the passes
+const size_t kMinRadixSortSize = 256;
+// Runs the merge sort starts from, sorted by insertion
+const size_t kMergeRunSize = 16;
+// Below this many points per thread the passes are not worth splitting, unless
+// the caller asks for the threads
+const size_t kMinPointsPerThread = 1 << 18;
+
+const int kDigitBits = 11;
+const int kNumBuckets = 1 << kDigitBits;
+// The digits of x, then those of y
+const int kPassesPerWord = (64 + kDigitBits - 1) / kDigitBits;
+const int kNumPasses = 2 * kPassesPerWord;
+
+// Maps a double to an integer with the same order. Negative zero is mapped
+// like positive zero, as they compare equal.
+std::uint64_t OrderedBits(double d)
+{
+  d += 0.0;
+  std::uint64_t bits;
+  std::memcpy(&bits, &d, sizeof(bits));
+  const std::uint64_t sign = std::uint64_t(1) << 63;
+  return (bits & sign) ? ~bits : bits | sign;
+}
+
+template <class Key>
+unsigned Digit(const Key& key, int pass)
+{
+  const std::uint64_t word = pass < kPassesPerWord ? key.x : key.y;
+  return static_cast<unsigned>(word >> ((pass % kPassesPerWord) * kDigitBits)) & (kNumBuckets - 1);
+}
+
+template <class Key>
+bool KeyLess(const Key& a, const Key& b)
+{
+  return a.y < b.y || (a.y == b.y && a.x < b.x);
+}
+
+// Runs f(0) .. f(num_threads - 1), each on its own thread
+template <class F>
+void ParallelFor(unsigned num_threads, F f)
+{
+  if (num_threads == 1) {
+    f(0);
+    return;
+  }
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (unsigned t = 1; t < num_threads; ++t) {
+    threads.emplace_back(f, t);
+  }
+  f(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace
+
+void PointSorter::Sort(std::vector<Point*>& points, unsigned num_threads)
+{
+  if (!SortKeys(points, num_threads)) {
+    return;
+  }
+  unsorted_.assign(points.begin(), points.end());
+  for (size_t i = 0; i < points.size(); ++i) {
+    points[i] = unsorted_[keys_[i].index];
+  }
+}
+
+void PointSorter::Sort(const std::vector<Point*>& input, std::vector<Point*>& sorted,
+                       std::vector<size_t>& ranks, unsigned num_threads)
+{
+  const size_t n = input.size();
+  sorted.resize(n);
+  ranks.resize(n);
+  if (!SortKeys(input, num_threads)) {
+    for (size_t i = 0; i < n; ++i) {
+      sorted[i] = input[i];
+      ranks[i] = i;
+    }
+    return;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    sorted[i] = input[keys_[i].index];
+    ranks[keys_[i].index] = i;
+  }
+}
+
+size_t PointSorter::reserved_bytes() const
+{
+  return (keys_.capacity() + buffer_.capacity()) * sizeof(Key) + counts_.capacity() * sizeof(size_t) +
+         unsorted_.capacity() * sizeof(Point*);
+}
+
+bool PointSorter::SortKeys(const std::vector<Point*>& points, unsigned num_threads)
+{
+  const size_t n = points.size();
+
+  // Gather the keys, noting whether they are sorted already
+  keys_.resize(n);
+  bool sorted = true;
+  for (size_t i = 0; i < n; ++i) {
+    keys_[i] = { OrderedBits(points[i]->y), OrderedBits(points[i]->x), i };
+    if (i > 0 && KeyLess(keys_[i], keys_[i - 1])) {
+      sorted = false;
+    }
+  }
+  if (sorted) {
+    return false;
+  }
+
+  buffer_.resize(n);
+  if (n < kMinRadixSortSize) {
+    MergeSort();
+  } else {
+    if (num_threads == 0) {
+      num_threads = static_cast<unsigned>(std::max<size_t>(
+        1, std::min<size_t>(std::thread::hardware_concurrency(), n / kMinPointsPerThread)));
+    }
+    RadixSort(num_threads);
+  }
+  return true;
+}
+
+void PointSorter::MergeSort()
+{
+  const size_t n = keys_.size();
+  for (size_t begin = 0; begin < n; begin += kMergeRunSize) {
+    const size_t end = std::min(n, begin + kMergeRunSize);
+    for (size_t i = begin + 1; i < end; ++i) {
+      const Key key = keys_[i];
+      size_t j = i;
+      for (; j > begin && KeyLess(key, keys_[j - 1]); --j) {
+        keys_[j] = keys_[j - 1];
+      }
+      keys_[j] = key;
+    }
+  }
+  for (size_t width = kMergeRunSize; width < n; width *= 2) {
+    for (size_t begin = 0; begin < n; begin += 2 * width) {
+      const auto first = keys_.begin() + begin;
+      const auto middle = keys_.begin() + std::min(n, begin + width);
+      const auto last = keys_.begin() + std::min(n, begin + 2 * width);
+      std::merge(first, middle, middle, last, buffer_.begin() + begin, KeyLess<Key>);
+    }
+    keys_.swap(buffer_);
+  }
+}
+
+void PointSorter::RadixSort(unsigned num_threads)
+{
+  // A pass over a digit that every key has is skipped
+  std::uint64_t x_varies = 0, y_varies = 0;
+  for (const auto& key : keys_) {
+    x_varies |= key.x ^ keys_[0].x;
+    y_varies |= key.y ^ keys_[0].y;
+  }
+
+  counts_.resize(num_threads * kNumBuckets);
+  for (int pass = 0; pass < kNumPasses; ++pass) {
+    const std::uint64_t varies = pass < kPassesPerWord ? x_varies : y_varies;
+    const int shift = (pass % kPassesPerWord) * kDigitBits;
+    if (((varies >> shift) & (kNumBuckets - 1)) == 0) {
+      continue;
+    }
+    RadixPass(pass, num_threads);
+    keys_.swap(buffer_);
+  }
+}
+
+// One stable counting pass from keys_ into buffer_. With several threads
+// every thread counts and then scatters its own slice of the keys, the slices
+// placed in order so that the result is the same as sorting on one thread.
+void PointSorter::RadixPass(int pass, unsigned num_threads)
+{
+  const size_t n = keys_.size();
+  auto slice_begin = [n, num_threads](unsigned t) { return n * t / num_threads; };
+
+  ParallelFor(num_threads, [&](unsigned t) {
+    size_t* count = &counts_[t * kNumBuckets];
+    std::fill(count, count + kNumBuckets, size_t(0));
+    for (size_t i = slice_begin(t); i < slice_begin(t + 1); ++i) {
+      ++count[Digit(keys_[i], pass)];
+    }
+  });
+
+  size_t offset = 0;
+  for (int b = 0; b < kNumBuckets; ++b) {
+    for (unsigned t = 0; t < num_threads; ++t) {
+      size_t& count = counts_[t * kNumBuckets + b];
+      const size_t bucket_size = count;
+      count = offset;
+      offset += bucket_size;
+    }
+  }
+
+  ParallelFor(num_threads, [&](unsigned t) {
+    size_t* next = &counts_[t * kNumBuckets];
+    for (size_t i = slice_begin(t); i < slice_begin(t + 1); ++i) {
+      buffer_[next[Digit(keys_[i], pass)]++] = keys_[i];
+    }
+  });
+}
+
+}
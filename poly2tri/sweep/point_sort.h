@@ -0,0 +1,105 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2018, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "../poly2tri_export.h"
+#include "../common/shapes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace p2t {
+
+/**
+ * Sorts points along the y-axis, then the x-axis, into the order of cmp.
+ * Points are sorted on packed keys of their coordinates instead of comparing
+ * them through the pointers, radix sorted unless there are only a few. The
+ * sort is stable, so points that compare equal keep their order.
+ *
+ * A sorter keeps its scratch buffers, so sorting inputs of similar sizes
+ * with the same sorter allocates no memory after the first.
+ */
+class POLY2TRI_API PointSorter {
+public:
+
+  /**
+   * @param points - the points to sort
+   * @param num_threads - threads to sort large inputs with, 0 picks one per
+   *                      hardware thread
+   */
+  void Sort(std::vector<Point*>& points, unsigned num_threads = 0);
+
+  /**
+   * Sorts a copy of the points, leaving them as they are
+   *
+   * @param input - the points to sort
+   * @param sorted - the points of input, sorted
+   * @param ranks - for each point of input, its position in sorted
+   * @param num_threads - as above
+   */
+  void Sort(const std::vector<Point*>& input, std::vector<Point*>& sorted,
+            std::vector<size_t>& ranks, unsigned num_threads = 0);
+
+  /// Bytes of the scratch buffers
+  size_t reserved_bytes() const;
+
+private:
+
+  struct Key {
+    std::uint64_t y;
+    std::uint64_t x;
+    // Position of the point in the input
+    size_t index;
+  };
+
+  /// Sorts keys_ for the points, returns false if they were in order
+  bool SortKeys(const std::vector<Point*>& points, unsigned num_threads);
+  void MergeSort();
+  void RadixSort(unsigned num_threads);
+  void RadixPass(int pass, unsigned num_threads);
+
+  std::vector<Key> keys_;
+  std::vector<Key> buffer_;
+  // Per thread bucket counts of a radix pass
+  std::vector<size_t> counts_;
+  // The points before sorting in place
+  std::vector<Point*> unsorted_;
+};
+
+/// Sorts points with a PointSorter of its own, see PointSorter::Sort
+inline void SortPoints(std::vector<Point*>& points, unsigned num_threads = 0)
+{
+  PointSorter().Sort(points, num_threads);
+}
+
+}
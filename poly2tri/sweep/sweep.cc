@@ -33,35 +33,119 @@
 #include "advancing_front.h"
 #include "../common/utils.h"
 
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
+#ifdef POLY2TRI_STATS
+#include <chrono>
+#endif
 
 namespace p2t {
 
 // Triangulate simple polygon with holes
-void Sweep::Triangulate(SweepContext& tcx)
+namespace {
+
+#ifdef POLY2TRI_STATS
+// Milliseconds since start, which is then moved on to now
+double Lap(std::chrono::steady_clock::time_point& start)
 {
-  tcx.InitTriangulation();
-  tcx.CreateAdvancingFront();
-  // Sweep points; build mesh
-  SweepPoints(tcx);
-  // Clean up
-  FinalizationPolygon(tcx);
+  const auto now = std::chrono::steady_clock::now();
+  const double ms = std::chrono::duration<double, std::milli>(now - start).count();
+  start = now;
+  return ms;
 }
+#endif
+
+} // namespace
 
-void Sweep::SweepPoints(SweepContext& tcx)
+template <class Kernel>
+void BasicSweep<Kernel>::Triangulate(SweepContext& tcx)
 {
-  for (size_t i = 1; i < tcx.point_count(); i++) {
-    Point& point = *tcx.GetPoint(i);
-    Node* node = &PointEvent(tcx, point);
-    for (auto& j : point.edge_list) {
-      EdgeEvent(tcx, j, node);
+  stats_ = TriangulationStats();
+#ifdef POLY2TRI_PREDICATE_COUNTERS
+  const PredicateCounters predicates = GetPredicateCounters();
+#endif
+  POLY2TRI_STAT(auto start = std::chrono::steady_clock::now());
+  TraceScope trace(tracer_, TracePhase::kTriangulate, tcx.point_count());
+  // A failed triangulation may have left work behind
+  legalize_stack_.clear();
+  edge_stack_.clear();
+  {
+    TraceScope init(tracer_, TracePhase::kInit, 0);
+    for (size_t i = 0; i < tcx.point_count(); i++) {
+      if (!Kernel::Accepts(*tcx.GetPoint(i))) {
+        throw poly2tri_exception("poly2tri: point out of the range of the predicate kernel");
+      }
+    }
+    tcx.InitTriangulation(Kernel::integral_coordinates);
+    POLY2TRI_STAT(stats_.init_ms = Lap(start));
+    tcx.CreateAdvancingFront();
+  }
+  {
+    // Sweep points; build mesh
+    TraceScope sweep(tracer_, TracePhase::kSweep, 0);
+    SweepPoints(tcx);
+    POLY2TRI_STAT(stats_.sweep_ms = Lap(start));
+  }
+  {
+    // Clean up
+    TraceScope finalize(tracer_, TracePhase::kFinalize, 0);
+    FinalizationPolygon(tcx);
+    POLY2TRI_STAT(stats_.finalize_ms = Lap(start));
+  }
+
+  POLY2TRI_STAT(stats_.locate_node_steps = tcx.front()->locate_steps());
+  POLY2TRI_STAT(stats_.max_front = tcx.front()->max_size());
+#ifdef POLY2TRI_PREDICATE_COUNTERS
+  const PredicateCounters& counters = GetPredicateCounters();
+  stats_.orient2d = counters.orient2d - predicates.orient2d;
+  stats_.orient2d_exact = counters.orient2d_exact - predicates.orient2d_exact;
+  stats_.incircle = counters.incircle - predicates.incircle;
+  stats_.incircle_exact = counters.incircle_exact - predicates.incircle_exact;
+#endif
+}
+
+template <class Kernel>
+void BasicSweep<Kernel>::SweepPoints(SweepContext& tcx)
+{
+  Tracer* const tracer = tracer_;
+  const size_t count = tcx.point_count();
+  // Without a tracer the sweep is one chunk, and no edge is long enough to trace
+  size_t chunk = count;
+  double long_edge = 0;
+  if (tracer && count > 0) {
+    chunk = std::max<size_t>(tracer->chunk_points, 1);
+    long_edge = tracer->long_edge * (tcx.GetPoint(count - 1)->y - tcx.GetPoint(0)->y);
+  }
+  for (size_t first = 1; first < count; first += chunk) {
+    TraceScope trace(tracer, TracePhase::kSweepChunk, first);
+    const size_t last = std::min(count, first + chunk);
+    for (size_t i = first; i < last; i++) {
+      Point& point = *tcx.GetPoint(i);
+      Node* node = &PointEvent(tcx, point);
+      for (Edge* edge : tcx.PointEdges(i)) {
+        if (tracer && edge->q->y - edge->p->y >= long_edge) {
+          TraceScope edge_trace(tracer, TracePhase::kEdgeEvent, i);
+          EdgeEvent(tcx, edge, node);
+        } else {
+          EdgeEvent(tcx, edge, node);
+        }
+      }
+      if (tcx.HarvestDue(i + 1)) {
+        tcx.Harvest(i + 1);
+      }
     }
   }
 }
 
-void Sweep::FinalizationPolygon(SweepContext& tcx)
+template <class Kernel>
+void BasicSweep<Kernel>::FinalizationPolygon(SweepContext& tcx)
 {
+  if (tcx.sink()) {
+    tcx.FinishStream();
+    return;
+  }
+
   // Get an Internal triangle to start with
   Triangle* t = tcx.front()->head()->next->triangle;
   Point* p = tcx.front()->head()->next->point;
@@ -75,8 +159,10 @@ void Sweep::FinalizationPolygon(SweepContext& tcx)
 }
 }
 
-Node& Sweep::PointEvent(SweepContext& tcx, Point& point)
+template <class Kernel>
+Node& BasicSweep<Kernel>::PointEvent(SweepContext& tcx, Point& point)
 {
+  POLY2TRI_STAT(++stats_.locate_node);
   Node* node_ptr = tcx.LocateNode(point);
   if (!node_ptr || !node_ptr->point || !node_ptr->next || !node_ptr->next->point)
   {
@@ -98,9 +184,12 @@ Node& Sweep::PointEvent(SweepContext& tcx, Point& point)
   return new_node;
 }
 
-void Sweep::EdgeEvent(SweepContext& tcx, Edge* edge, Node* node)
+template <class Kernel>
+void BasicSweep<Kernel>::EdgeEvent(SweepContext& tcx, Edge* edge, Node* node)
 {
+  POLY2TRI_STAT(++stats_.edge_events);
   tcx.edge_event.constrained_edge = edge;
+  tcx.edge_event.upper = edge->q;
   tcx.edge_event.right = (edge->p->x > edge->q->x);
 
   if (IsEdgeSideOfTriangle(*node->triangle, *edge->p, *edge->q)) {
@@ -121,121 +210,100 @@ void Sweep::EdgeEvent(SweepContext& tcx, Edge* edge, Node* node)
   }
 }
 
-void Sweep::EdgeEvent(SweepContext& tcx, Point& ep, Point& eq, Triangle* triangle, Point& point)
-{
-	GEOMETRIX_ASSERT( triangle );
-	Triangle* prevTrig = triangle;
-	if( triangle )
-	{
-		if( IsEdgeSideOfTriangle( *triangle, ep, eq ) )
-		{
-			return;
-		}
-
-		Point* p1 = triangle->PointCCW( point );
-		if( p1 != nullptr )
-		{
-			Orientation o1 = Orient2d( eq, *p1, ep );
-			if( o1 == COLLINEAR )
-			{
-				if( triangle->Contains( &eq, p1 ) )
-				{
-					triangle->MarkConstrainedEdge( &eq, p1 );
-					// We are modifying the constraint maybe it would be better to
-					// not change the given constraint and just keep a variable for the new constraint
-					tcx.edge_event.constrained_edge->q = p1;
-					triangle = triangle->NeighborAcross( point );
-					if( triangle )
-					{
-						EdgeEvent( tcx, ep, *p1, triangle, *p1 );
-					}
-                    else
-                    {
-						throw null_triangle_exception( prevTrig );
-                    }
-				}
-				else
-				{
-					// std::runtime_error("EdgeEvent - collinear points not supported");
-					throw collinear_points_exception( eq, *p1, ep );
-				}
-				return;
-			}
-			Point* p2 = triangle->PointCW( point );
-			if( p2 != nullptr )
-			{
-				Orientation o2 = Orient2d( eq, *p2, ep );
-				if( o2 == COLLINEAR )
-				{
-					if( triangle->Contains( &eq, p2 ) )
-					{
-						triangle->MarkConstrainedEdge( &eq, p2 );
-						// We are modifying the constraint maybe it would be better to
-						// not change the given constraint and just keep a variable for the new constraint
-						tcx.edge_event.constrained_edge->q = p2;
-						triangle = triangle->NeighborAcross( point );
-						if( triangle )
-						{
-							EdgeEvent( tcx, ep, *p2, triangle, *p2 );
-						}
-						else
-						{
-							throw null_triangle_exception( prevTrig );
-						}
-					}
-					else
-					{
-						// std::runtime_error("EdgeEvent - collinear points not supported");
-						throw collinear_points_exception( eq, *p2, ep );
-					}
-					return;
-				}
-
-				if( o1 == o2 )
-				{
-					// Need to decide if we are rotating CW or CCW to get to a triangle
-					// that will cross edge
-					if( o1 == CW )
-					{
-						triangle = triangle->NeighborCCW( point );
-					}
-					else
-					{
-						triangle = triangle->NeighborCW( point );
-					}
-					if( triangle )
-					{
-						EdgeEvent( tcx, ep, eq, triangle, point );
-					}
-					else
-					{
-						throw null_triangle_exception( prevTrig );
-					}
-				}
-				else
-				{
-					// This triangle crosses constraint so lets flippin start!
+template <class Kernel>
+void BasicSweep<Kernel>::EdgeEvent(SweepContext& tcx, Point& ep, Point& eq, Triangle* triangle, Point& point)
+{
+  // FlipEdgeEvent leaves the edge events it has to resume on edge_stack_; they
+  // run here, last in first out, as they would have unwound from recursion
+  const size_t base = edge_stack_.size();
+  edge_stack_.push_back({ &ep, &eq, triangle, &point });
+
+  while (edge_stack_.size() > base) {
+    const EdgeTask task = edge_stack_.back();
+    edge_stack_.pop_back();
+
+    Point& ep = *task.ep;
+    Point* eq = task.eq;
+    Point* point = task.point;
+    triangle = task.triangle;
     assert(triangle);
-					FlipEdgeEvent( tcx, ep, eq, triangle, point );
-				}
-			}
-			else
-			{
-				throw degenerate_triangle_exception{ *triangle->GetPoint( 0 ), *triangle->GetPoint( 1 ), *triangle->GetPoint( 2 ) };
-			}
-		}
-		else
-		{
-			throw degenerate_triangle_exception{ *triangle->GetPoint( 0 ), *triangle->GetPoint( 1 ), *triangle->GetPoint( 2 ) };
-		}
-	}
-	else
-	{
-		throw null_triangle_exception{ prevTrig };
-	}
-}
-
-bool Sweep::IsEdgeSideOfTriangle(Triangle& triangle, Point& ep, Point& eq)
+
+    // Walk around point until we reach the triangle that crosses the edge
+    Triangle* prevTrig = triangle;
+    for (;;) {
+      if (IsEdgeSideOfTriangle(*triangle, ep, *eq)) {
+        break;
+      }
+
+      Point* p1 = triangle->PointCCW(*point);
+      if (p1 == nullptr) {
+        throw degenerate_triangle_exception{ *triangle->GetPoint(0), *triangle->GetPoint(1), *triangle->GetPoint(2) };
+      }
+      Orientation o1 = Orient2d<Kernel>(*eq, *p1, ep);
+      if (o1 == COLLINEAR) {
+        if (!triangle->Contains(eq, p1)) {
+          // std::runtime_error("EdgeEvent - collinear points not supported");
+          throw collinear_points_exception(*eq, *p1, ep);
+        }
+        triangle->MarkConstrainedEdge(eq, p1);
+        // The rest of the constraint runs from p1
+        tcx.edge_event.upper = p1;
+        triangle = triangle->NeighborAcross(*point);
+        if (!triangle) {
+          throw null_triangle_exception(prevTrig);
+        }
+        // Continue with the rest of the edge, from p1 to ep
+        prevTrig = triangle;
+        eq = point = p1;
+        continue;
+      }
+
+      Point* p2 = triangle->PointCW(*point);
+      if (p2 == nullptr) {
+        throw degenerate_triangle_exception{ *triangle->GetPoint(0), *triangle->GetPoint(1), *triangle->GetPoint(2) };
+      }
+      Orientation o2 = Orient2d<Kernel>(*eq, *p2, ep);
+      if (o2 == COLLINEAR) {
+        if (!triangle->Contains(eq, p2)) {
+          // std::runtime_error("EdgeEvent - collinear points not supported");
+          throw collinear_points_exception(*eq, *p2, ep);
+        }
+        triangle->MarkConstrainedEdge(eq, p2);
+        // The rest of the constraint runs from p2
+        tcx.edge_event.upper = p2;
+        triangle = triangle->NeighborAcross(*point);
+        if (!triangle) {
+          throw null_triangle_exception(prevTrig);
+        }
+        prevTrig = triangle;
+        eq = point = p2;
+        continue;
+      }
+
+      if (o1 == o2) {
+        // Need to decide if we are rotating CW or CCW to get to a triangle
+        // that will cross edge
+        if (o1 == CW) {
+          triangle = triangle->NeighborCCW(*point);
+        } else {
+          triangle = triangle->NeighborCW(*point);
+        }
+        if (!triangle) {
+          throw null_triangle_exception(prevTrig);
+        }
+        prevTrig = triangle;
+        continue;
+      }
+
+      // This triangle crosses constraint so lets flippin start!
+      FlipEdgeEvent(tcx, ep, *eq, triangle, *point);
+      break;
+    }
+  }
+}
+
+template <class Kernel>
+bool BasicSweep<Kernel>::IsEdgeSideOfTriangle(Triangle& triangle, Point& ep, Point& eq)
 {
   const int index = triangle.EdgeIndex(&ep, &eq);
 
@@ -250,21 +318,16 @@ bool Sweep::IsEdgeSideOfTriangle(Triangle& triangle, Point& ep, Point& eq)
   return false;
 }
 
-Node& Sweep::NewFrontTriangle(SweepContext& tcx, Point& point, Node& node)
+template <class Kernel>
+Node& BasicSweep<Kernel>::NewFrontTriangle(SweepContext& tcx, Point& point, Node& node)
 {
   //GEOMETRIX_ASSERT(node.next);
-  Triangle* triangle = new Triangle(point, *node.point, *node.next->point);
+  Triangle* triangle = tcx.NewTriangle(point, *node.point, *node.next->point);
 
   triangle->MarkNeighbor(*node.triangle);
-  tcx.AddToMap(triangle);
-
-  Node* new_node = new Node(point);
-  nodes_.push_back(new_node);
 
-  new_node->next = node.next;
-  new_node->prev = &node;
-  node.next->prev = new_node;
-  node.next = new_node;
+  Node* new_node = tcx.NewNode(point);
+  tcx.front()->InsertAfter(node, *new_node);
 
   if (!Legalize(tcx, *triangle)) {
     tcx.MapTriangleToNodes(*triangle);
@@ -273,28 +336,30 @@ Node& Sweep::NewFrontTriangle(SweepContext& tcx, Point& point, Node& node)
   return *new_node;
 }
 
-void Sweep::Fill(SweepContext& tcx, Node& node)
+template <class Kernel>
+void BasicSweep<Kernel>::Fill(SweepContext& tcx, Node& node)
 {
-  Triangle* triangle = new Triangle(*node.prev->point, *node.point, *node.next->point);
+  POLY2TRI_STAT(++stats_.fills);
+  Triangle* triangle = tcx.NewTriangle(*node.prev->point, *node.point, *node.next->point);
 
   // TODO: should copy the constrained_edge value from neighbor triangles
   //       for now constrained_edge values are copied during the legalize
   triangle->MarkNeighbor(*node.prev->triangle);
   triangle->MarkNeighbor(*node.triangle);
 
-  tcx.AddToMap(triangle);
-
   // Update the advancing front
-  node.prev->next = node.next;
-  node.next->prev = node.prev;
+  tcx.front()->Remove(node);
 
   // If it was legalized the triangle has already been mapped
   if (!Legalize(tcx, *triangle)) {
     tcx.MapTriangleToNodes(*triangle);
   }
+
+  tcx.RemoveNode(&node);
 }
 
-void Sweep::FillAdvancingFront(SweepContext& tcx, Node& n)
+template <class Kernel>
+void BasicSweep<Kernel>::FillAdvancingFront(SweepContext& tcx, Node& n)
 {
 
   // Fill right holes
@@ -303,8 +368,9 @@ void Sweep::FillAdvancingFront(SweepContext& tcx, Node& n)
   while (node && node->next) {
     // if HoleAngle exceeds 90 degrees then break.
     if (LargeHole_DontFill(node)) break;
+    Node* next = node->next;
     Fill(tcx, *node);
-    node = node->next;
+    node = next;
   }
 
   // Fill left holes
@@ -313,14 +379,14 @@ void Sweep::FillAdvancingFront(SweepContext& tcx, Node& n)
   while (node && node->prev) {
     // if HoleAngle exceeds 90 degrees then break.
     if (LargeHole_DontFill(node)) break;
+    Node* prev = node->prev;
     Fill(tcx, *node);
-    node = node->prev;
+    node = prev;
   }
 
   // Fill right basins
   if (n.next && n.next->next) {
-    const double angle = BasinAngle(n);
-    if (angle < PI_3div4) {
+    if (SmallBasinAngle(n)) {
       FillBasin(tcx, n);
     }
   }
@@ -356,91 +422,106 @@ void Sweep::FillAdvancingFront(SweepContext& tcx, Node& n)
 //           | /
 //           |/
 //           C
-bool Sweep::LargeHole_DontFill(const Node* node) const {
+template <class Kernel>
+bool BasicSweep<Kernel>::LargeHole_DontFill(const Node* node) const {
 
   const Node* nextNode = node->next;
   const Node* prevNode = node->prev;
-  if (!AngleExceeds90Degrees(node->point, nextNode->point, prevNode->point))
+  double cross, dot;
+  AngleCrossDot(*node->point, *nextNode->point, *prevNode->point, cross, dot);
+  if (!AngleExceeds90Degrees(cross, dot))
           return false;
 
-  if (AngleIsNegative(node->point, nextNode->point, prevNode->point))
+  if (AngleIsNegative(cross, dot))
           return true;
 
   // Check additional points on front.
   const Node* next2Node = nextNode->next;
   // "..Plus.." because only want angles on same side as point being added.
-  if ((next2Node != nullptr) && !AngleExceedsPlus90DegreesOrIsNegative(node->point, next2Node->point, prevNode->point))
+  if ((next2Node != nullptr) && !AngleExceedsPlus90DegreesOrIsNegative(*node->point, *next2Node->point, *prevNode->point))
           return false;
 
   const Node* prev2Node = prevNode->prev;
   // "..Plus.." because only want angles on same side as point being added.
-  if ((prev2Node != nullptr) && !AngleExceedsPlus90DegreesOrIsNegative(node->point, nextNode->point, prev2Node->point))
+  if ((prev2Node != nullptr) && !AngleExceedsPlus90DegreesOrIsNegative(*node->point, *nextNode->point, *prev2Node->point))
           return false;
 
   return true;
 }
 
-bool Sweep::AngleIsNegative(const Point* origin, const Point* pa, const Point* pb) const {
-    const double angle = Angle(origin, pa, pb);
-    return angle < 0;
-}
-
-bool Sweep::AngleExceeds90Degrees(const Point* origin, const Point* pa, const Point* pb) const {
-  const double angle = Angle(origin, pa, pb);
-  return ((angle > PI_div2) || (angle < -PI_div2));
-}
-
-bool Sweep::AngleExceedsPlus90DegreesOrIsNegative(const Point* origin, const Point* pa, const Point* pb) const {
-  const double angle = Angle(origin, pa, pb);
-  return (angle > PI_div2) || (angle < 0);
-}
-
-double Sweep::Angle(const Point* origin, const Point* pa, const Point* pb) const {
-  /* Complex plane
-   * ab = cosA +i*sinA
-   * ab = (ax + ay*i)(bx + by*i) = (ax*bx + ay*by) + i(ax*by-ay*bx)
-   * atan2(y,x) computes the principal value of the argument function
-   * applied to the complex number x+iy
-   * Where x = ax*bx + ay*by
-   *       y = ax*by - ay*bx
-   */
-  const double px = origin->x;
-  const double py = origin->y;
-  const double ax = pa->x- px;
-  const double ay = pa->y - py;
-  const double bx = pb->x - px;
-  const double by = pb->y - py;
-  const double x = ax * by - ay * bx;
-  const double y = ax * bx + ay * by;
-  return atan2(x, y);
-}
-
-double Sweep::BasinAngle(const Node& node) const
+template <class Kernel>
+bool BasicSweep<Kernel>::SmallBasinAngle(const Node& node) const
 {
   const double ax = node.point->x - node.next->next->point->x;
   const double ay = node.point->y - node.next->next->point->y;
-  return atan2(ay, ax);
+  return !DirectionExceeds135Degrees(ax, ay);
 }
 
-double Sweep::HoleAngle(const Node& node) const
+template <class Kernel>
+bool BasicSweep<Kernel>::Legalize(SweepContext& tcx, Triangle& t)
 {
-  /* Complex plane
-   * ab = cosA +i*sinA
-   * ab = (ax + ay*i)(bx + by*i) = (ax*bx + ay*by) + i(ax*by-ay*bx)
-   * atan2(y,x) computes the principal value of the argument function
-   * applied to the complex number x+iy
-   * Where x = ax*bx + ay*by
-   *       y = ax*by - ay*bx
-   */
-  const double ax = node.next->point->x - node.point->x;
-  const double ay = node.next->point->y - node.point->y;
-  const double bx = node.prev->point->x - node.point->x;
-  const double by = node.prev->point->y - node.point->y;
-  return atan2(ax * by - ay * bx, ax * bx + ay * by);
+  // Every flip leaves two triangles to legalize in turn, t first. Each frame on
+  // the worklist stands for one such triangle and records how far it has got,
+  // so a cascade of flips needs no call stack. The base allows this to be
+  // entered again while a legalization is in progress.
+  const size_t base = legalize_stack_.size();
+  legalize_stack_.push_back({ &t, nullptr, 0, 0, LegalizeFrame::kScan });
+
+  // Result of the frame that finished last
+  bool legalized = false;
+
+  while (legalize_stack_.size() > base) {
+    LegalizeFrame& frame = legalize_stack_.back();
+    switch (frame.stage) {
+    case LegalizeFrame::kScan:
+      if (!LegalizeEdge(frame)) {
+        legalized = false;
+        legalize_stack_.pop_back();
+        break;
+      }
+      // We now got one valid Delaunay Edge shared by two triangles
+      // This gives us 4 new edges to check for Delaunay
+      frame.stage = LegalizeFrame::kFirstDone;
+      legalize_stack_.push_back({ frame.t, nullptr, 0, 0, LegalizeFrame::kScan });
+      break;
+
+    case LegalizeFrame::kFirstDone:
+      // Make sure that triangle to node mapping is done only one time for a specific triangle
+      if (!legalized) {
+        tcx.MapTriangleToNodes(*frame.t);
+      }
+      frame.stage = LegalizeFrame::kSecondDone;
+      legalize_stack_.push_back({ frame.ot, nullptr, 0, 0, LegalizeFrame::kScan });
+      break;
+
+    case LegalizeFrame::kSecondDone:
+      if (!legalized) {
+        tcx.MapTriangleToNodes(*frame.ot);
+      }
+
+      // Reset the Delaunay edges, since they only are valid Delaunay edges
+      // until we add a new triangle or point.
+      // XXX: need to think about this. Can these edges be tried after we
+      //      return to previous recursive level?
+      frame.t->delaunay_edge[frame.i] = false;
+      frame.ot->delaunay_edge[frame.oi] = false;
+
+      // If triangle have been legalized no need to check the other edges since
+      // the legalization of the pair handles those so we can end here.
+      legalized = true;
+      legalize_stack_.pop_back();
+      break;
+    }
+  }
+  return legalized;
 }
 
-bool Sweep::Legalize(SweepContext& tcx, Triangle& t)
+template <class Kernel>
+bool BasicSweep<Kernel>::LegalizeEdge(LegalizeFrame& frame)
 {
+  POLY2TRI_STAT(++stats_.legalize);
+  Triangle& t = *frame.t;
+
   // To legalize a triangle we start by finding if any of the three edges
   // violate the Delaunay condition
   for (int i = 0; i < 3; i++) {
@@ -470,29 +551,11 @@ bool Sweep::Legalize(SweepContext& tcx, Triangle& t)
 
         // Lets rotate shared edge one vertex CW to legalize it
         RotateTrianglePair(t, *p, *ot, *op);
+        ++stats_.flips;
 
-        // We now got one valid Delaunay Edge shared by two triangles
-        // This gives us 4 new edges to check for Delaunay
-
-        // Make sure that triangle to node mapping is done only one time for a specific triangle
-        bool not_legalized = !Legalize(tcx, t);
-        if (not_legalized) {
-          tcx.MapTriangleToNodes(t);
-        }
-
-        not_legalized = !Legalize(tcx, *ot);
-        if (not_legalized)
-          tcx.MapTriangleToNodes(*ot);
-
-        // Reset the Delaunay edges, since they only are valid Delaunay edges
-        // until we add a new triangle or point.
-        // XXX: need to think about this. Can these edges be tried after we
-        //      return to previous recursive level?
-        t.delaunay_edge[i] = false;
-        ot->delaunay_edge[oi] = false;
-
-        // If triangle have been legalized no need to check the other edges since
-        // the recursive legalization will handles those so we can end here.
+        frame.ot = ot;
+        frame.i = i;
+        frame.oi = oi;
         return true;
       }
     }
@@ -500,96 +563,14 @@ bool Sweep::Legalize(SweepContext& tcx, Triangle& t)
   return false;
 }
 
-namespace {
-	bool IncircleOld(const Point& pa, const Point& pb, const Point& pc, const Point& pd)
-	{
-	  const double adx = pa.x - pd.x;
-	  const double ady = pa.y - pd.y;
-	  const double bdx = pb.x - pd.x;
-	  const double bdy = pb.y - pd.y;
-
-	  const double adxbdy = adx * bdy;
-	  const double bdxady = bdx * ady;
-	  const double oabd = adxbdy - bdxady;
-
-	  if (oabd <= 0)
-		return false;
-
-	  const double cdx = pc.x - pd.x;
-	  const double cdy = pc.y - pd.y;
-
-	  const double cdxady = cdx * ady;
-	  const double adxcdy = adx * cdy;
-	  const double ocad = cdxady - adxcdy;
-
-	  if (ocad <= 0)
-		return false;
-
-	  const double bdxcdy = bdx * cdy;
-	  const double cdxbdy = cdx * bdy;
-
-	  const double alift = adx * adx + ady * ady;
-	  const double blift = bdx * bdx + bdy * bdy;
-	  const double clift = cdx * cdx + cdy * cdy;
-
-	  const double det = alift * (bdxcdy - cdxbdy) + blift * ocad + clift * oabd;
-
-	  return det > 0;
-	}
-}
-bool Sweep::Incircle(const Point& pa, const Point& pb, const Point& pc, const Point& pd) const
+template <class Kernel>
+bool BasicSweep<Kernel>::Incircle(const Point& pa, const Point& pb, const Point& pc, const Point& pd) const
 {
-#ifndef POLY2TRI_USE_EXACT
-  const double adx = pa.x - pd.x;
-  const double ady = pa.y - pd.y;
-  const double bdx = pb.x - pd.x;
-  const double bdy = pb.y - pd.y;
-
-  const double adxbdy = adx * bdy;
-  const double bdxady = bdx * ady;
-  const double oabd = adxbdy - bdxady;
-
-  if (oabd <= 0)
-    return false;
-
-  const double cdx = pc.x - pd.x;
-  const double cdy = pc.y - pd.y;
-
-  const double cdxady = cdx * ady;
-  const double adxcdy = adx * cdy;
-  const double ocad = cdxady - adxcdy;
-
-  if (ocad <= 0)
-    return false;
-
-  const double bdxcdy = bdx * cdy;
-  const double cdxbdy = cdx * bdy;
-
-  const double alift = adx * adx + ady * ady;
-  const double blift = bdx * bdx + bdy * bdy;
-  const double clift = cdx * cdx + cdy * cdy;
-
-  const double det = alift * (bdxcdy - cdxbdy) + blift * ocad + clift * oabd;
-
-  return det > 0;
-#else
-	std::array<double, 2> a = { pa.x, pa.y };
-	std::array<double, 2> b = { pb.x, pb.y };
-	std::array<double, 2> c = { pc.x, pc.y };
-	std::array<double, 2> d = { pd.x, pd.y };
-	auto r = exact::in_circumcircle(a, b, c, d) != geometrix::oriented_right;
-
-//#ifndef NDEBUG
-//	std::array<geometrix::point<double, 2>, 3> trig = { geometrix::point<double,2>{a[0], a[1]}, geometrix::point<double,2>{b[0], b[1]}, geometrix::point<double,2>{c[0], c[1]} };
-//	geometrix::point<double, 2> gd(d[0], d[1]);
-	//GEOMETRIX_ASSERT(r == IncircleOld(pa, pb, pc, pd));
-//#endif
-
-	return r;
-#endif
+  return Kernel::Incircle(pa, pb, pc, pd);
 }
 
-void Sweep::RotateTrianglePair(Triangle& t, Point& p, Triangle& ot, Point& op) const
+template <class Kernel>
+void BasicSweep<Kernel>::RotateTrianglePair(Triangle& t, Point& p, Triangle& ot, Point& op) const
 {
   Triangle* n1, *n2, *n3, *n4;
   n1 = t.NeighborCCW(p);
@@ -638,9 +619,11 @@ void Sweep::RotateTrianglePair(Triangle& t, Point& p, Triangle& ot, Point& op) c
   t.MarkNeighbor(ot);
 }
 
-void Sweep::FillBasin(SweepContext& tcx, Node& node)
+template <class Kernel>
+void BasicSweep<Kernel>::FillBasin(SweepContext& tcx, Node& node)
 {
-  if (Orient2d(*node.point, *node.next->point, *node.next->next->point) == CCW) {
+  POLY2TRI_STAT(++stats_.fill_basin);
+  if (Orient2d<Kernel>(*node.point, *node.next->point, *node.next->next->point) == CCW) {
     tcx.basin.left_node = node.next->next;
   } else {
     tcx.basin.left_node = node.next;
@@ -673,42 +656,44 @@ void Sweep::FillBasin(SweepContext& tcx, Node& node)
   FillBasinReq(tcx, tcx.basin.bottom_node);
 }
 
-void Sweep::FillBasinReq(SweepContext& tcx, Node* node)
+template <class Kernel>
+void BasicSweep<Kernel>::FillBasinReq(SweepContext& tcx, Node* node)
 {
   // if shallow stop filling
-  if (IsShallow(tcx, *node)) {
-    return;
-  }
-
-  Fill(tcx, *node);
+  while (!IsShallow(tcx, *node)) {
+    // The node goes back to the pool once filled, so keep what we need of it
+    Point* point = node->point;
+    Node* prev = node->prev;
+    Node* next = node->next;
+    Fill(tcx, *node);
 
-  if (node->prev == tcx.basin.left_node && node->next == tcx.basin.right_node) {
-    return;
-  } else if (node->prev == tcx.basin.left_node) {
-    Orientation o = Orient2d(*node->point, *node->next->point, *node->next->next->point);
-    if (o == CW) {
+    if (prev == tcx.basin.left_node && next == tcx.basin.right_node) {
       return;
-    }
-    node = node->next;
-  } else if (node->next == tcx.basin.right_node) {
-    Orientation o = Orient2d(*node->point, *node->prev->point, *node->prev->prev->point);
-    if (o == CCW) {
-      return;
-    }
-    node = node->prev;
-  } else {
-    // Continue with the neighbor node with lowest Y value
-    if (node->prev->point->y < node->next->point->y) {
-      node = node->prev;
+    } else if (prev == tcx.basin.left_node) {
+      Orientation o = Orient2d<Kernel>(*point, *next->point, *next->next->point);
+      if (o == CW) {
+        return;
+      }
+      node = next;
+    } else if (next == tcx.basin.right_node) {
+      Orientation o = Orient2d<Kernel>(*point, *prev->point, *prev->prev->point);
+      if (o == CCW) {
+        return;
+      }
+      node = prev;
     } else {
-      node = node->next;
+      // Continue with the neighbor node with lowest Y value
+      if (prev->point->y < next->point->y) {
+        node = prev;
+      } else {
+        node = next;
+      }
     }
   }
-
-  FillBasinReq(tcx, node);
 }
 
-bool Sweep::IsShallow(SweepContext& tcx, Node& node)
+template <class Kernel>
+bool BasicSweep<Kernel>::IsShallow(SweepContext& tcx, Node& node)
 {
   double height;
 
@@ -725,7 +710,8 @@ bool Sweep::IsShallow(SweepContext& tcx, Node& node)
   return false;
 }
 
-void Sweep::FillEdgeEvent(SweepContext& tcx, Edge* edge, Node* node)
+template <class Kernel>
+void BasicSweep<Kernel>::FillEdgeEvent(SweepContext& tcx, Edge* edge, Node* node)
 {
   if (tcx.edge_event.right) {
     FillRightAboveEdgeEvent(tcx, edge, node);
@@ -734,11 +720,12 @@ void Sweep::FillEdgeEvent(SweepContext& tcx, Edge* edge, Node* node)
   }
 }
 
-void Sweep::FillRightAboveEdgeEvent(SweepContext& tcx, Edge* edge, Node* node)
+template <class Kernel>
+void BasicSweep<Kernel>::FillRightAboveEdgeEvent(SweepContext& tcx, Edge* edge, Node* node)
 {
   while (node->next->point->x < edge->p->x) {
     // Check if next node is below the edge
-    if (Orient2d(*edge->q, *node->next->point, *edge->p) == CCW) {
+    if (Orient2d<Kernel>(*edge->q, *node->next->point, *edge->p) == CCW) {
       FillRightBelowEdgeEvent(tcx, edge, *node);
     } else {
       node = node->next;
@@ -746,61 +733,71 @@ void Sweep::FillRightAboveEdgeEvent(SweepContext& tcx, Edge* edge, Node* node)
   }
 }
 
-void Sweep::FillRightBelowEdgeEvent(SweepContext& tcx, Edge* edge, Node& node)
+template <class Kernel>
+void BasicSweep<Kernel>::FillRightBelowEdgeEvent(SweepContext& tcx, Edge* edge, Node& node)
 {
-  if (node.point->x < edge->p->x) {
-    if (Orient2d(*node.point, *node.next->point, *node.next->next->point) == CCW) {
+  while (node.point->x < edge->p->x) {
+    if (Orient2d<Kernel>(*node.point, *node.next->point, *node.next->next->point) == CCW) {
       // Concave
       FillRightConcaveEdgeEvent(tcx, edge, node);
-    } else{
-      // Convex
-      FillRightConvexEdgeEvent(tcx, edge, node);
-      // Retry this one
-      FillRightBelowEdgeEvent(tcx, edge, node);
+      return;
     }
+    // Convex
+    FillRightConvexEdgeEvent(tcx, edge, node);
+    // Retry this one
   }
 }
 
-void Sweep::FillRightConcaveEdgeEvent(SweepContext& tcx, Edge* edge, Node& node)
+template <class Kernel>
+void BasicSweep<Kernel>::FillRightConcaveEdgeEvent(SweepContext& tcx, Edge* edge, Node& node)
 {
-  Fill(tcx, *node.next);
-  if (node.next->point != edge->p) {
+  for (;;) {
+    Fill(tcx, *node.next);
+    if (node.next->point == edge->p) {
+      return;
+    }
     // Next above or below edge?
-    if (Orient2d(*edge->q, *node.next->point, *edge->p) == CCW) {
-      // Below
-      if (Orient2d(*node.point, *node.next->point, *node.next->next->point) == CCW) {
-        // Next is concave
-        FillRightConcaveEdgeEvent(tcx, edge, node);
-      } else {
-        // Next is convex
-      }
+    if (Orient2d<Kernel>(*edge->q, *node.next->point, *edge->p) != CCW) {
+      // Above
+      return;
     }
+    // Below
+    if (Orient2d<Kernel>(*node.point, *node.next->point, *node.next->next->point) != CCW) {
+      // Next is convex
+      return;
+    }
+    // Next is concave
   }
 }
 
-void Sweep::FillRightConvexEdgeEvent(SweepContext& tcx, Edge* edge, Node& node)
+template <class Kernel>
+void BasicSweep<Kernel>::FillRightConvexEdgeEvent(SweepContext& tcx, Edge* edge, Node& start)
 {
-  // Next concave or convex?
-  if (Orient2d(*node.next->point, *node.next->next->point, *node.next->next->next->point) == CCW) {
-    // Concave
-    FillRightConcaveEdgeEvent(tcx, edge, *node.next);
-  } else{
+  Node* node = &start;
+  for (;;) {
+    // Next concave or convex?
+    if (Orient2d<Kernel>(*node->next->point, *node->next->next->point, *node->next->next->next->point) == CCW) {
+      // Concave
+      FillRightConcaveEdgeEvent(tcx, edge, *node->next);
+      return;
+    }
     // Convex
     // Next above or below edge?
-    if (Orient2d(*edge->q, *node.next->next->point, *edge->p) == CCW) {
-      // Below
-      FillRightConvexEdgeEvent(tcx, edge, *node.next);
-    } else{
+    if (Orient2d<Kernel>(*edge->q, *node->next->next->point, *edge->p) != CCW) {
       // Above
+      return;
     }
+    // Below
+    node = node->next;
   }
 }
 
-void Sweep::FillLeftAboveEdgeEvent(SweepContext& tcx, Edge* edge, Node* node)
+template <class Kernel>
+void BasicSweep<Kernel>::FillLeftAboveEdgeEvent(SweepContext& tcx, Edge* edge, Node* node)
 {
   while (node->prev->point->x > edge->p->x) {
     // Check if next node is below the edge
-    if (Orient2d(*edge->q, *node->prev->point, *edge->p) == CW) {
+    if (Orient2d<Kernel>(*edge->q, *node->prev->point, *edge->p) == CW) {
       FillLeftBelowEdgeEvent(tcx, edge, *node);
     } else {
       node = node->prev;
@@ -808,95 +805,121 @@ void Sweep::FillLeftAboveEdgeEvent(SweepContext& tcx, Edge* edge, Node* node)
   }
 }
 
-void Sweep::FillLeftBelowEdgeEvent(SweepContext& tcx, Edge* edge, Node& node)
+template <class Kernel>
+void BasicSweep<Kernel>::FillLeftBelowEdgeEvent(SweepContext& tcx, Edge* edge, Node& node)
 {
-  if (node.point->x > edge->p->x) {
-    if (Orient2d(*node.point, *node.prev->point, *node.prev->prev->point) == CW) {
+  while (node.point->x > edge->p->x) {
+    if (Orient2d<Kernel>(*node.point, *node.prev->point, *node.prev->prev->point) == CW) {
       // Concave
       FillLeftConcaveEdgeEvent(tcx, edge, node);
-    } else {
-      // Convex
-      FillLeftConvexEdgeEvent(tcx, edge, node);
-      // Retry this one
-      FillLeftBelowEdgeEvent(tcx, edge, node);
+      return;
     }
+    // Convex
+    FillLeftConvexEdgeEvent(tcx, edge, node);
+    // Retry this one
   }
 }
 
-void Sweep::FillLeftConvexEdgeEvent(SweepContext& tcx, Edge* edge, Node& node)
+template <class Kernel>
+void BasicSweep<Kernel>::FillLeftConvexEdgeEvent(SweepContext& tcx, Edge* edge, Node& start)
 {
-  // Next concave or convex?
-  if (Orient2d(*node.prev->point, *node.prev->prev->point, *node.prev->prev->prev->point) == CW) {
-    // Concave
-    FillLeftConcaveEdgeEvent(tcx, edge, *node.prev);
-  } else{
+  Node* node = &start;
+  for (;;) {
+    // Next concave or convex?
+    if (Orient2d<Kernel>(*node->prev->point, *node->prev->prev->point, *node->prev->prev->prev->point) == CW) {
+      // Concave
+      FillLeftConcaveEdgeEvent(tcx, edge, *node->prev);
+      return;
+    }
     // Convex
     // Next above or below edge?
-    if (Orient2d(*edge->q, *node.prev->prev->point, *edge->p) == CW) {
-      // Below
-      FillLeftConvexEdgeEvent(tcx, edge, *node.prev);
-    } else{
+    if (Orient2d<Kernel>(*edge->q, *node->prev->prev->point, *edge->p) != CW) {
       // Above
+      return;
     }
+    // Below
+    node = node->prev;
   }
 }
 
-void Sweep::FillLeftConcaveEdgeEvent(SweepContext& tcx, Edge* edge, Node& node)
+template <class Kernel>
+void BasicSweep<Kernel>::FillLeftConcaveEdgeEvent(SweepContext& tcx, Edge* edge, Node& node)
 {
-  Fill(tcx, *node.prev);
-  if (node.prev->point != edge->p) {
+  for (;;) {
+    Fill(tcx, *node.prev);
+    if (node.prev->point == edge->p) {
+      return;
+    }
     // Next above or below edge?
-    if (Orient2d(*edge->q, *node.prev->point, *edge->p) == CW) {
-      // Below
-      if (Orient2d(*node.point, *node.prev->point, *node.prev->prev->point) == CW) {
-        // Next is concave
-        FillLeftConcaveEdgeEvent(tcx, edge, node);
-      } else{
-        // Next is convex
-      }
+    if (Orient2d<Kernel>(*edge->q, *node.prev->point, *edge->p) != CW) {
+      // Above
+      return;
     }
+    // Below
+    if (Orient2d<Kernel>(*node.point, *node.prev->point, *node.prev->prev->point) != CW) {
+      // Next is convex
+      return;
+    }
+    // Next is concave
   }
 }
 
-void Sweep::FlipEdgeEvent(SweepContext& tcx, Point& ep, Point& eq, Triangle* t, Point& p)
+template <class Kernel>
+void BasicSweep<Kernel>::FlipEdgeEvent(SweepContext& tcx, Point& edge_p, Point& edge_q, Triangle* t, Point& flip_p)
 {
-  assert(t);
-  Triangle* ot_ptr = t->NeighborAcross(p);
-  if (ot_ptr == nullptr)
-  {
-    throw std::runtime_error("FlipEdgeEvent - null neighbor across");
-  }
-  Triangle& ot = *ot_ptr;
-  Point& op = *ot.OppositePoint(*t, p);
-
-  if (InScanArea(p, *t->PointCCW(p), *t->PointCW(p), op)) {
-    // Lets rotate shared edge one vertex CW
-    RotateTrianglePair(*t, p, ot, op);
-    tcx.MapTriangleToNodes(*t);
-    tcx.MapTriangleToNodes(ot);
-
-    if (p == eq && op == ep) {
-      if (eq == *tcx.edge_event.constrained_edge->q && ep == *tcx.edge_event.constrained_edge->p) {
-        t->MarkConstrainedEdge(&ep, &eq);
-        ot.MarkConstrainedEdge(&ep, &eq);
-        Legalize(tcx, *t);
-        Legalize(tcx, ot);
-      } else {
-        // XXX: I think one of the triangles should be legalized here?
+  Point* ep = &edge_p;
+  Point* eq = &edge_q;
+  Point* p = &flip_p;
+  for (;;) {
+    assert(t);
+    Triangle* ot_ptr = t->NeighborAcross(*p);
+    if (ot_ptr == nullptr)
+    {
+      throw std::runtime_error("FlipEdgeEvent - null neighbor across");
+    }
+    Triangle& ot = *ot_ptr;
+    Point& op = *ot.OppositePoint(*t, *p);
+
+    if (InScanArea<Kernel>(*p, *t->PointCCW(*p), *t->PointCW(*p), op)) {
+      // Lets rotate shared edge one vertex CW
+      RotateTrianglePair(*t, *p, ot, op);
+      POLY2TRI_STAT(++stats_.edge_flips);
+      tcx.MapTriangleToNodes(*t);
+      tcx.MapTriangleToNodes(ot);
+
+      if (*p == *eq && op == *ep) {
+        if (*eq == *tcx.edge_event.upper && *ep == *tcx.edge_event.constrained_edge->p) {
+          t->MarkConstrainedEdge(ep, eq);
+          ot.MarkConstrainedEdge(ep, eq);
+          Legalize(tcx, *t);
+          Legalize(tcx, ot);
+        } else {
+          // XXX: I think one of the triangles should be legalized here?
+        }
+        return;
       }
+      Orientation o = Orient2d<Kernel>(*eq, op, *ep);
+      t = &NextFlipTriangle(tcx, o, *t, ot, *p, op);
     } else {
-      Orientation o = Orient2d(eq, op, ep);
-      t = &NextFlipTriangle(tcx, o, *t, ot, p, op);
-      FlipEdgeEvent(tcx, ep, eq, t, p);
+      // Once the scan and the flips it leads to are done, the edge event
+      // carries on from t; EdgeEvent picks that up from the stack
+      edge_stack_.push_back({ ep, eq, t, p });
+
+      Point& newP = NextFlipPoint(*ep, *eq, ot, op);
+      Triangle* flip_triangle = t;
+      t = &ot;
+      p = &newP;
+      FlipScanEdgeEvent(*ep, *eq, *flip_triangle, t, p);
+
+      // Flip the new edge from eq to the point found by the scan
+      ep = eq;
+      eq = p;
     }
-  } else {
-    Point& newP = NextFlipPoint(ep, eq, ot, op);
-    FlipScanEdgeEvent(tcx, ep, eq, *t, ot, newP);
-    EdgeEvent(tcx, ep, eq, t, p);
   }
 }
 
-Triangle& Sweep::NextFlipTriangle(SweepContext& tcx, Orientation o, Triangle& t, Triangle& ot, Point& p, Point& op)
+template <class Kernel>
+Triangle& BasicSweep<Kernel>::NextFlipTriangle(SweepContext& tcx, Orientation o, Triangle& t, Triangle& ot, Point& p, Point& op)
 {
   if (o == CCW) {
     // ot is not crossing edge after flip
@@ -916,9 +939,10 @@ Triangle& Sweep::NextFlipTriangle(SweepContext& tcx, Orientation o, Triangle& t,
   return ot;
 }
 
-Point& Sweep::NextFlipPoint(Point& ep, Point& eq, Triangle& ot, Point& op)
+template <class Kernel>
+Point& BasicSweep<Kernel>::NextFlipPoint(Point& ep, Point& eq, Triangle& ot, Point& op)
 {
-  Orientation o2d = Orient2d(eq, op, ep);
+  Orientation o2d = Orient2d<Kernel>(eq, op, ep);
   if (o2d == CW) {
     // Right
     return *ot.PointCCW(op);
@@ -929,50 +953,45 @@ Point& Sweep::NextFlipPoint(Point& ep, Point& eq, Triangle& ot, Point& op)
   throw collinear_points_exception(eq, op, ep);// std::runtime_error("[Unsupported] Opposing point on constrained edge");
 }
 
-void Sweep::FlipScanEdgeEvent(SweepContext& tcx, Point& ep, Point& eq, Triangle& flip_triangle,
-                              Triangle& t, Point& p)
+template <class Kernel>
+void BasicSweep<Kernel>::FlipScanEdgeEvent(Point& ep, Point& eq, Triangle& flip_triangle,
+                                           Triangle*& t, Point*& p)
 {
-  Triangle* ot_ptr = t.NeighborAcross(p);
-  if (ot_ptr == nullptr) {
-    throw std::runtime_error("FlipScanEdgeEvent - null neighbor across");
-  }
-
-  Point* op_ptr = ot_ptr->OppositePoint(t, p);
-  if (op_ptr == nullptr) {
-    throw std::runtime_error("FlipScanEdgeEvent - null opposing point");
-  }
+  for (;;) {
+    Triangle* ot_ptr = t->NeighborAcross(*p);
+    if (ot_ptr == nullptr) {
+      throw std::runtime_error("FlipScanEdgeEvent - null neighbor across");
+    }
 
-  Point* p1 = flip_triangle.PointCCW(eq);
-  Point* p2 = flip_triangle.PointCW(eq);
-  if (p1 == nullptr || p2 == nullptr) {
-    throw std::runtime_error("FlipScanEdgeEvent - null on either of points");
-  }
+    Point* op_ptr = ot_ptr->OppositePoint(*t, *p);
+    if (op_ptr == nullptr) {
+      throw std::runtime_error("FlipScanEdgeEvent - null opposing point");
+    }
 
-  Triangle& ot = *ot_ptr;
-  Point& op = *op_ptr;
+    Point* p1 = flip_triangle.PointCCW(eq);
+    Point* p2 = flip_triangle.PointCW(eq);
+    if (p1 == nullptr || p2 == nullptr) {
+      throw std::runtime_error("FlipScanEdgeEvent - null on either of points");
+    }
 
-  if (InScanArea(eq, *p1, *p2, op)) {
-    // flip with new edge op->eq
-    FlipEdgeEvent(tcx, eq, op, &ot, op);
-    // TODO: Actually I just figured out that it should be possible to
-    //       improve this by getting the next ot and op before the the above
-    //       flip and continue the flipScanEdgeEvent here
-    // set new ot and op here and loop back to inScanArea test
-    // also need to set a new flip_triangle first
-    // Turns out at first glance that this is somewhat complicated
-    // so it will have to wait.
-  } else{
-    Point& newP = NextFlipPoint(ep, eq, ot, op);
-    FlipScanEdgeEvent(tcx, ep, eq, flip_triangle, ot, newP);
+    if (InScanArea<Kernel>(eq, *p1, *p2, *op_ptr)) {
+      // flip with new edge op->eq
+      t = ot_ptr;
+      p = op_ptr;
+      return;
+    }
+    p = &NextFlipPoint(ep, eq, *ot_ptr, *op_ptr);
+    t = ot_ptr;
   }
 }
 
-Sweep::~Sweep() {
-    // Clean up memory
-    for (auto& node : nodes_) {
-      delete node;
-    }
-}
+template class BasicSweep<InexactKernel>;
+#ifdef POLY2TRI_USE_EXACT
+template class BasicSweep<FilteredExactKernel>;
+#endif
+#ifdef __SIZEOF_INT128__
+template class BasicSweep<IntegerExactKernel>;
+#endif
 
 }//! namespace pt2;
 
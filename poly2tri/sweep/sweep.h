@@ -39,7 +39,13 @@
 #pragma once
 
 #include "../poly2tri_export.h"
+#include "../common/memory_usage.h"
 #include "../common/orientation.h"
+#include "../common/shapes.h"
+#include "../common/stats.h"
+#include "../common/trace.h"
+#include "../common/utils.h"
+#include <cstddef>
 #include <vector>
 
 namespace p2t {
@@ -50,7 +56,13 @@ struct Point;
 struct Edge;
 class Triangle;
 
-class POLY2TRI_API Sweep
+/**
+ * The sweep, with its geometric predicates taken from Kernel (see utils.h).
+ * The library is built with InexactKernel, FilteredExactKernel and, where the
+ * compiler has 128 bit integers, IntegerExactKernel.
+ */
+template <class Kernel>
+class POLY2TRI_API BasicSweep
 {
 public:
 
@@ -62,12 +74,59 @@ public:
   void Triangulate(SweepContext& tcx);
 
   /**
-   * Destructor - clean up memory
+   * Number of edge flips done by legalization in the last triangulation
    */
-  ~Sweep();
+  size_t flip_count() const { return static_cast<size_t>(stats_.flips); }
+
+  /**
+   * Counters and phase timers of the last triangulation, see TriangulationStats
+   */
+  const TriangulationStats& stats() const { return stats_; }
+
+  /**
+   * Add the memory of the worklists to report
+   */
+  void AddMemoryUsage(MemoryReport& report) const
+  {
+    report.scratch.AddBuffer(legalize_stack_);
+    report.scratch.AddBuffer(edge_stack_);
+  }
+
+  /**
+   * Report the phases of the following triangulations to tracer, or stop
+   * reporting them if it is null. The tracer must outlive its use.
+   */
+  void set_tracer(Tracer* tracer) { tracer_ = tracer; }
+  Tracer* tracer() const { return tracer_; }
 
 private:
 
+  // Legalization state of one triangle, see Legalize
+  struct LegalizeFrame {
+    enum Stage { kScan, kFirstDone, kSecondDone };
+
+    Triangle* t;
+    Triangle* ot;
+    int i;
+    int oi;
+    Stage stage;
+  };
+
+  // Edge event to resume once the flips it started are done, see EdgeEvent
+  struct EdgeTask {
+    Point* ep;
+    Point* eq;
+    Triangle* triangle;
+    Point* point;
+  };
+
+  // Worklists of Legalize and EdgeEvent, kept between calls so that their
+  // storage is reused
+  std::vector<LegalizeFrame> legalize_stack_;
+  std::vector<EdgeTask> edge_stack_;
+  TriangulationStats stats_;
+  Tracer* tracer_ = nullptr;
+
   /**
    * Start sweeping the Y-sorted point set from bottom to top
    *
@@ -119,6 +178,12 @@ private:
    */
   bool Legalize(SweepContext& tcx, Triangle& t);
 
+  /**
+   * Looks for an edge of the frame's triangle that violates the Delaunay
+   * condition and flips it. Returns false if there was none.
+   */
+  bool LegalizeEdge(LegalizeFrame& frame);
+
   /**
    * <b>Requirement</b>:<br>
    * 1. a,b and c form a triangle.<br>
@@ -173,22 +238,12 @@ private:
   // Decision-making about when to Fill hole.
   // Contributed by ToolmakerSteve2
   bool LargeHole_DontFill(const Node* node) const;
-  bool AngleIsNegative(const Point* origin, const Point* pa, const Point* pb) const;
-  bool AngleExceeds90Degrees(const Point* origin, const Point* pa, const Point* pb) const;
-  bool AngleExceedsPlus90DegreesOrIsNegative(const Point* origin, const Point* pa, const Point* pb) const;
-  double Angle(const Point* origin, const Point* pa, const Point* pb) const;
-
-  /**
-   *
-   * @param node - middle node
-   * @return the angle between 3 front nodes
-   */
-  double HoleAngle(const Node& node) const;
 
   /**
-   * The basin angle is decided against the horizontal line [1,0]
+   * True if the basin angle is less than 135 degrees. The basin angle is
+   * decided against the horizontal line [1,0]
    */
-  double BasinAngle(const Node& node) const;
+  bool SmallBasinAngle(const Node& node) const;
 
   /**
    * Fills a basin that has formed on the Advancing Front to the right
@@ -202,11 +257,10 @@ private:
   void FillBasin(SweepContext& tcx, Node& node);
 
   /**
-   * Recursive algorithm to fill a Basin with triangles
+   * Fills a Basin with triangles, working up from its bottom
    *
    * @param tcx
    * @param node - bottom_node
-   * @param cnt - counter used to alternate on even and odd numbers
    */
   void FillBasinReq(SweepContext& tcx, Node* node);
 
@@ -222,7 +276,7 @@ private:
 
   void FillRightConcaveEdgeEvent(SweepContext& tcx, Edge* edge, Node& node);
 
-  void FillRightConvexEdgeEvent(SweepContext& tcx, Edge* edge, Node& node);
+  void FillRightConvexEdgeEvent(SweepContext& tcx, Edge* edge, Node& start);
 
   void FillLeftAboveEdgeEvent(SweepContext& tcx, Edge* edge, Node* node);
 
@@ -230,9 +284,14 @@ private:
 
   void FillLeftConcaveEdgeEvent(SweepContext& tcx, Edge* edge, Node& node);
 
-  void FillLeftConvexEdgeEvent(SweepContext& tcx, Edge* edge, Node& node);
+  void FillLeftConvexEdgeEvent(SweepContext& tcx, Edge* edge, Node& start);
 
-  void FlipEdgeEvent(SweepContext& tcx, Point& ep, Point& eq, Triangle* t, Point& p);
+  /**
+   * Flips the triangles crossing edge_p-edge_q, starting from t at flip_p.
+   * Where a scan is needed the edge event that has to resume afterwards is
+   * pushed on edge_stack_ for EdgeEvent to run.
+   */
+  void FlipEdgeEvent(SweepContext& tcx, Point& edge_p, Point& edge_q, Triangle* t, Point& flip_p);
 
   /**
    * After a flip we have two triangles and know that only one will still be
@@ -265,21 +324,28 @@ private:
      * Scan part of the FlipScan algorithm<br>
      * When a triangle pair isn't flippable we will scan for the next
      * point that is inside the flip triangle scan area. When found
-     * we generate a new flipEdgeEvent
+     * we continue with a flip of the edge from eq to that point
      *
-     * @param tcx
      * @param ep - last point on the edge we are traversing
      * @param eq - first point on the edge we are traversing
      * @param flipTriangle - the current triangle sharing the point eq with edge
-     * @param t
-     * @param p
+     * @param t - in: triangle to scan from, out: triangle to flip
+     * @param p - in: point to scan from, out: the point found
      */
-  void FlipScanEdgeEvent(SweepContext& tcx, Point& ep, Point& eq, Triangle& flip_triangle, Triangle& t, Point& p);
+  void FlipScanEdgeEvent(Point& ep, Point& eq, Triangle& flip_triangle, Triangle*& t, Point*& p);
 
   void FinalizationPolygon(SweepContext& tcx);
 
-  std::vector<Node*> nodes_;
-
 };
 
+extern template class BasicSweep<InexactKernel>;
+#ifdef POLY2TRI_USE_EXACT
+extern template class BasicSweep<FilteredExactKernel>;
+#endif
+#ifdef __SIZEOF_INT128__
+extern template class BasicSweep<IntegerExactKernel>;
+#endif
+
+typedef BasicSweep<DefaultKernel> Sweep;
+
 }
@@ -30,11 +30,37 @@
  */
 #include "sweep_context.h"
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include "advancing_front.h"
 
 namespace p2t {
 
+namespace {
+
+// Fewest points swept between two harvests. Past it a harvest waits for as
+// many points as half the live triangles, which bounds its cost per point.
+const size_t kMinHarvestPoints = 256;
+
+size_t EdgeSlot(const Point* a, const Point* b, int shift)
+{
+  if (std::less<const Point*>()(b, a)) {
+    std::swap(a, b);
+  }
+  const std::uint64_t h = (reinterpret_cast<std::uintptr_t>(a) * 0x9E3779B97F4A7C15ull) ^
+                          reinterpret_cast<std::uintptr_t>(b);
+  return static_cast<size_t>((h * 0x9E3779B97F4A7C15ull) >> shift);
+}
+
+} // namespace
+
 SweepContext::SweepContext(std::vector<Point*> polyline) : points_(std::move(polyline)),
+  sink_(nullptr),
+  next_harvest_(0),
+  last_sweep_y_(0),
+  lower_cursor_(0),
+  edge_lookup_shift_(0),
   front_(nullptr),
   head_(nullptr),
   tail_(nullptr),
@@ -42,12 +68,35 @@ SweepContext::SweepContext(std::vector<Point*> polyline) : points_(std::move(pol
   af_middle_(nullptr),
   af_tail_(nullptr)
 {
-  InitEdges(points_);
+  InitEdges(points_, 0, false);
+}
+
+void SweepContext::Reset(const std::vector<Point*>& polyline)
+{
+  head_ = nullptr;
+  tail_ = nullptr;
+  af_head_ = af_middle_ = af_tail_ = nullptr;
+
+  edge_list.clear();
+  edge_ends_.clear();
+  edge_starts_.clear();
+  edge_interior_left_.clear();
+  edge_pool_.Clear();
+  finished_.clear();
+
+  triangles_.clear();
+  map_.Clear();
+  node_pool_.Clear();
+  basin.Clear();
+  edge_event = EdgeEvent();
+
+  points_.assign(polyline.begin(), polyline.end());
+  InitEdges(points_, 0, false);
 }
 
 void SweepContext::AddHole(const std::vector<Point*>& polyline)
 {
-  InitEdges(polyline);
+  InitEdges(polyline, points_.size(), true);
   for (auto i : polyline) {
     points_.push_back(i);
   }
@@ -62,12 +111,12 @@ std::vector<Triangle*> &SweepContext::GetTriangles()
   return triangles_;
 }
 
-std::list<Triangle*> &SweepContext::GetMap()
+TriangleMap &SweepContext::GetMap()
 {
   return map_;
 }
 
-void SweepContext::InitTriangulation()
+void SweepContext::InitTriangulation(bool integral_sentinels)
 {
   double xmax(points_[0]->x), xmin(points_[0]->x);
   double ymax(points_[0]->y), ymin(points_[0]->y);
@@ -87,20 +136,384 @@ void SweepContext::InitTriangulation()
 
   double dx = kAlpha * (xmax - xmin);
   double dy = kAlpha * (ymax - ymin);
-  head_ = new Point(xmin - dx, ymin - dy);
-  tail_ = new Point(xmax + dx, ymin - dy);
-
-  // Sort points along y-axis
-  std::sort(points_.begin(), points_.end(), cmp);
+  if (integral_sentinels) {
+    head_point_.set(std::floor(xmin - dx), std::floor(ymin - dy));
+    tail_point_.set(std::ceil(xmax + dx), std::floor(ymin - dy));
+  } else {
+    head_point_.set(xmin - dx, ymin - dy);
+    tail_point_.set(xmax + dx, ymin - dy);
+  }
+  head_ = &head_point_;
+  tail_ = &tail_point_;
+
+  // Sort points along y-axis, keeping the order they were added in
+  input_points_.swap(points_);
+  sorter_.Sort(input_points_, points_, point_ranks_);
+  InitEdgeTable();
+  if (sink_) {
+    InitStream();
+  }
 
 }
 
-void SweepContext::InitEdges(const std::vector<Point*>& polyline)
+void SweepContext::InitEdges(const std::vector<Point*>& polyline, size_t first_index, bool hole)
 {
   size_t num_points = polyline.size();
+  // Twice the signed area, positive if the polyline runs counterclockwise.
+  // The polygon is then left of an outline edge and right of a hole edge.
+  double area = 0;
+  for (size_t i = 0; i < num_points; i++) {
+    size_t j = i < num_points - 1 ? i + 1 : 0;
+    area += polyline[i]->x * polyline[j]->y - polyline[j]->x * polyline[i]->y;
+  }
+  const bool interior_left = (area > 0) != hole;
+
   for (size_t i = 0; i < num_points; i++) {
     size_t j = i < num_points - 1 ? i + 1 : 0;
-    edge_list.push_back(new Edge(*polyline[i], *polyline[j]));
+    Edge* edge = edge_pool_.Create(*polyline[i], *polyline[j]);
+    const bool forward = edge->p == polyline[i];
+    edge_list.push_back(edge);
+    edge_starts_.push_back(first_index + (forward ? i : j));
+    edge_ends_.push_back(first_index + (forward ? j : i));
+    edge_interior_left_.push_back(interior_left == forward);
+  }
+}
+
+void SweepContext::InitEdgeTable()
+{
+  // Count the edges of each point into the offset after its own, so that
+  // placing the edges moves each offset on to where the point's edges start
+  edge_offsets_.assign(points_.size() + 2, 0);
+  for (size_t end : edge_ends_) {
+    ++edge_offsets_[point_ranks_[end] + 2];
+  }
+  for (size_t i = 2; i < edge_offsets_.size(); ++i) {
+    edge_offsets_[i] += edge_offsets_[i - 1];
+  }
+  edge_table_.resize(edge_list.size());
+  for (size_t e = 0; e < edge_list.size(); ++e) {
+    edge_table_[edge_offsets_[point_ranks_[edge_ends_[e]] + 1]++] = edge_list[e];
+  }
+}
+
+void SweepContext::InitStream()
+{
+  finished_.clear();
+  pending_edges_.clear();
+  next_harvest_ = kMinHarvestPoints;
+  last_sweep_y_ = points_.empty() ? 0 : points_[0]->y;
+
+  edges_by_lower_.resize(edge_list.size());
+  for (size_t e = 0; e < edge_list.size(); ++e) {
+    edges_by_lower_[e] = e;
+  }
+  std::sort(edges_by_lower_.begin(), edges_by_lower_.end(), [this](size_t a, size_t b) {
+    return point_ranks_[edge_starts_[a]] < point_ranks_[edge_starts_[b]];
+  });
+  lower_cursor_ = 0;
+
+  size_t capacity = 16;
+  edge_lookup_shift_ = 64 - 4;
+  while (capacity < 2 * edge_list.size()) {
+    capacity *= 2;
+    --edge_lookup_shift_;
+  }
+  edge_lookup_.assign(capacity, edge_list.size());
+  for (size_t e = 0; e < edge_list.size(); ++e) {
+    size_t s = EdgeSlot(edge_list[e]->p, edge_list[e]->q, edge_lookup_shift_);
+    while (edge_lookup_[s] != edge_list.size()) {
+      s = (s + 1) & (capacity - 1);
+    }
+    edge_lookup_[s] = e;
+  }
+}
+
+size_t SweepContext::FindEdge(const Point* a, const Point* b) const
+{
+  const size_t mask = edge_lookup_.size() - 1;
+  for (size_t s = EdgeSlot(a, b, edge_lookup_shift_); edge_lookup_[s] != edge_list.size();
+       s = (s + 1) & mask) {
+    const Edge& edge = *edge_list[edge_lookup_[s]];
+    if ((edge.p == a && edge.q == b) || (edge.p == b && edge.q == a)) {
+      return edge_lookup_[s];
+    }
+  }
+  return edge_list.size();
+}
+
+void SweepContext::set_sink(TriangleSink* sink)
+{
+  sink_ = sink;
+}
+
+void SweepContext::Harvest(size_t processed)
+{
+  const double sweep_y = points_[processed - 1]->y;
+
+  // The constrained edges that the sweep is part way through, whose edge
+  // events will flip the triangles they cross
+  while (lower_cursor_ < edges_by_lower_.size() &&
+         point_ranks_[edge_starts_[edges_by_lower_[lower_cursor_]]] < processed) {
+    pending_edges_.push_back(edges_by_lower_[lower_cursor_++]);
+  }
+  pending_edges_.erase(std::remove_if(pending_edges_.begin(), pending_edges_.end(),
+                                      [this, processed](size_t e) {
+                                        return point_ranks_[edge_ends_[e]] < processed;
+                                      }),
+                       pending_edges_.end());
+  spans_.clear();
+  for (size_t e : pending_edges_) {
+    const Edge& edge = *edge_list[e];
+    EdgeSpan span;
+    span.px = edge.p->x;
+    span.py = edge.p->y;
+    span.qx = edge.q->x;
+    span.qy = edge.q->y;
+    span.xmin = std::min(span.px, span.qx);
+    span.xmax = std::max(span.px, span.qx);
+    spans_.push_back(span);
+  }
+  std::sort(spans_.begin(), spans_.end(),
+            [](const EdgeSpan& a, const EdgeSpan& b) { return a.xmin < b.xmin; });
+  for (size_t s = 0; s < spans_.size(); ++s) {
+    spans_[s].reach = s > 0 ? std::max(spans_[s - 1].reach, spans_[s].xmax) : spans_[s].xmax;
+  }
+
+  // The advancing front, with the lowest point over any range of its nodes
+  front_x_.clear();
+  front_min_y_.resize(1);
+  front_min_y_[0].clear();
+  for (Node* node = front_->head(); node; node = node->next) {
+    front_x_.push_back(node->value);
+    front_min_y_[0].push_back(node->point->y);
+  }
+  for (size_t k = 1; (size_t(1) << k) <= front_x_.size(); ++k) {
+    front_min_y_.resize(k + 1);
+    const std::vector<double>& below = front_min_y_[k - 1];
+    std::vector<double>& level = front_min_y_[k];
+    const size_t half = size_t(1) << (k - 1);
+    level.resize(front_x_.size() - 2 * half + 1);
+    for (size_t i = 0; i < level.size(); ++i) {
+      level[i] = std::min(below[i], below[i + half]);
+    }
+  }
+
+  const double advance = sweep_y - last_sweep_y_;
+  last_sweep_y_ = sweep_y;
+  for (Triangle* t : map_) {
+    if (t->IsFinal()) {
+      continue;
+    }
+    if (t->HarvestWait() > 0) {
+      t->HarvestWait(t->HarvestWait() - 1);
+    } else if (IsSettled(*t, sweep_y, advance)) {
+      t->IsFinal(true);
+      finished_.push_back(t);
+    }
+  }
+  Classify();
+
+  // Release the triangles that their neighbors no longer need either
+  size_t kept = 0;
+  for (Triangle* t : finished_) {
+    bool done = t->IsClassified();
+    for (int i = 0; i < 3 && done; ++i) {
+      const Triangle* neighbor = t->GetNeighbor(i);
+      done = !neighbor || neighbor->IsFinal();
+    }
+    if (done) {
+      map_.Remove(t);
+    } else {
+      finished_[kept++] = t;
+    }
+  }
+  finished_.resize(kept);
+
+  next_harvest_ = processed + std::max(kMinHarvestPoints, map_.size() / 2);
+}
+
+void SweepContext::FinishStream()
+{
+  for (Triangle* t : map_) {
+    if (!t->IsFinal()) {
+      t->IsFinal(true);
+      finished_.push_back(t);
+    }
+  }
+  lower_cursor_ = edges_by_lower_.size();
+  Classify();
+}
+
+bool SweepContext::IsSettled(Triangle& t, double sweep_y, double advance) const
+{
+  for (int i = 0; i < 3; ++i) {
+    const Point* p = t.GetPoint(i);
+    if (p == head_ || p == tail_ || !t.GetNeighbor(i)) {
+      return false;
+    }
+  }
+
+  // The circumcircle, relative to the first point. Points swept later lie
+  // above sweep_y, so they are outside it if it stays below, with a margin
+  // for rounding. A degenerate triangle gives an infinite or NaN top.
+  const Point& a = *t.GetPoint(0);
+  const Point& b = *t.GetPoint(1);
+  const Point& c = *t.GetPoint(2);
+  const double bx = b.x - a.x, by = b.y - a.y;
+  const double cx = c.x - a.x, cy = c.y - a.y;
+  const double d = 2 * (bx * cy - by * cx);
+  const double b2 = bx * bx + by * by, c2 = cx * cx + cy * cy;
+  const double ux = (cy * b2 - by * c2) / d;
+  const double uy = (bx * c2 - cx * b2) / d;
+  const double r = std::sqrt(ux * ux + uy * uy);
+  const double x = a.x + ux, y = a.y + uy;
+  const double margin = 1e-6 * (r + std::fabs(x) + std::fabs(y));
+  const double top = y + r + margin;
+  if (!(top < sweep_y)) {
+    // Not before the sweep gets past the top, if it keeps its pace. A
+    // wrong guess, as when t is flipped meanwhile, only holds it longer.
+    if (advance > 0 && top < sweep_y + 255 * advance) {
+      t.HarvestWait(static_cast<std::uint8_t>((top - sweep_y) / advance));
+    }
+    return false;
+  }
+
+  // No part of the front under the circle may lie that low, as filling
+  // it in could reach the triangle
+  const double left = x - r - margin, right = x + r + margin;
+  size_t lo = static_cast<size_t>(std::upper_bound(front_x_.begin(), front_x_.end(), left) -
+                                  front_x_.begin());
+  lo = lo > 0 ? lo - 1 : 0;
+  size_t hi = static_cast<size_t>(std::lower_bound(front_x_.begin(), front_x_.end(), right) -
+                                  front_x_.begin());
+  hi = std::min(hi, front_x_.size() - 1);
+  size_t k = 0;
+  while ((size_t(2) << k) <= hi - lo + 1) {
+    ++k;
+  }
+  const double front_y = std::min(front_min_y_[k][lo], front_min_y_[k][hi + 1 - (size_t(1) << k)]);
+  if (front_y <= top) {
+    return false;
+  }
+
+  // Nor may a constrained edge still to be inserted touch the triangle
+  const double xmin = std::min(a.x, std::min(b.x, c.x)) - margin;
+  const double xmax = std::max(a.x, std::max(b.x, c.x)) + margin;
+  const double ymin = std::min(a.y, std::min(b.y, c.y)) - margin;
+  const double ymax = std::max(a.y, std::max(b.y, c.y)) + margin;
+  size_t s = static_cast<size_t>(
+      std::upper_bound(spans_.begin(), spans_.end(), xmax,
+                       [](double v, const EdgeSpan& span) { return v < span.xmin; }) -
+      spans_.begin());
+  for (; s > 0 && spans_[s - 1].reach >= xmin; --s) {
+    const EdgeSpan& span = spans_[s - 1];
+    const double y0 = std::max(ymin, span.py), y1 = std::min(ymax, span.qy);
+    if (span.xmax < xmin || y0 > y1) {
+      continue;
+    }
+    double x0 = span.xmin, x1 = span.xmax;
+    if (span.qy > span.py) {
+      x0 = span.px + (span.qx - span.px) * (y0 - span.py) / (span.qy - span.py);
+      x1 = span.px + (span.qx - span.px) * (y1 - span.py) / (span.qy - span.py);
+    }
+    if (std::max(x0, x1) >= xmin && std::min(x0, x1) <= xmax) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SweepContext::SideOfConstraint(Triangle& t, bool& interior) const
+{
+  const Point* p = nullptr;
+  size_t e = edge_list.size();
+  for (int i = 0; i < 3 && e == edge_list.size(); ++i) {
+    if (t.constrained_edge[i]) {
+      p = t.GetPoint((i + 1) % 3);
+      e = FindEdge(p, t.GetPoint((i + 2) % 3));
+    }
+  }
+  if (e == edge_list.size()) {
+    return false;
+  }
+  // t is left of its points i + 1 to i + 2, as they run counterclockwise
+  interior = (edge_list[e]->p == p) == (edge_interior_left_[e] != 0);
+
+  return true;
+}
+
+bool SweepContext::IsInside(double x, double y) const
+{
+  bool inside = false;
+  for (size_t k = 0; k < lower_cursor_; ++k) {
+    const Edge& edge = *edge_list[edges_by_lower_[k]];
+    if (edge.p->y <= y && y < edge.q->y) {
+      // The point is right of the edge, going up
+      const double cross = (edge.q->x - edge.p->x) * (y - edge.p->y) -
+                           (edge.q->y - edge.p->y) * (x - edge.p->x);
+      inside = inside != (cross < 0);
+    }
+  }
+  return inside;
+}
+
+void SweepContext::Classify()
+{
+  const auto mark = [this](Triangle& t, bool interior) {
+    t.IsClassified(true);
+    t.IsInterior(interior);
+    if (interior) {
+      sink_->Consume(t);
+    }
+  };
+
+  // Spread the side of the polygon to the finished neighbors, changing
+  // sides across constrained edges
+  std::vector<Triangle*>& stack = harvest_stack_;
+  const auto spread = [&stack, &mark](Triangle& start) {
+    stack.clear();
+    stack.push_back(&start);
+    while (!stack.empty()) {
+      Triangle* t = stack.back();
+      stack.pop_back();
+      for (int i = 0; i < 3; ++i) {
+        Triangle* neighbor = t->GetNeighbor(i);
+        if (neighbor && neighbor->IsFinal() && !neighbor->IsClassified()) {
+          mark(*neighbor, t->IsInterior() != t->constrained_edge[i]);
+          stack.push_back(neighbor);
+        }
+      }
+    }
+  };
+
+  // Start from the triangles next to those already classified or on an
+  // edge of the polygon, then cast rays for what is left, which takes one
+  // per group of triangles cut off from those
+  for (Triangle* t : finished_) {
+    if (t->IsClassified()) {
+      continue;
+    }
+    bool interior = false;
+    int i = 0;
+    while (i < 3 && !(t->GetNeighbor(i) && t->GetNeighbor(i)->IsClassified())) {
+      ++i;
+    }
+    if (i < 3) {
+      mark(*t, t->GetNeighbor(i)->IsInterior() != t->constrained_edge[i]);
+      spread(*t);
+    } else if (SideOfConstraint(*t, interior)) {
+      mark(*t, interior);
+      spread(*t);
+    }
+  }
+  for (Triangle* t : finished_) {
+    if (!t->IsClassified()) {
+      const Point& a = *t->GetPoint(0);
+      const Point& b = *t->GetPoint(1);
+      const Point& c = *t->GetPoint(2);
+      mark(*t, IsInside((a.x + b.x + c.x) / 3, (a.y + b.y + c.y) / 3));
+      spread(*t);
+    }
   }
 }
 
@@ -109,14 +522,13 @@ Point* SweepContext::GetPoint(size_t index)
   return points_[index];
 }
 
-void SweepContext::AddToMap(Triangle* triangle)
+Triangle* SweepContext::NewTriangle(Point& a, Point& b, Point& c)
 {
-  map_.push_back(triangle);
+  return map_.Create(a, b, c);
 }
 
 Node* SweepContext::LocateNode(const Point& point)
 {
-  // TODO implement search tree
   return front_->LocateNode(point.x);
 }
 
@@ -124,26 +536,30 @@ void SweepContext::CreateAdvancingFront()
 {
 
   // Initial triangle
-  Triangle* triangle = new Triangle(*points_[0], *head_, *tail_);
-
-  map_.push_back(triangle);
-
-  af_head_ = new Node(*triangle->GetPoint(1), *triangle);
-  af_middle_ = new Node(*triangle->GetPoint(0), *triangle);
-  af_tail_ = new Node(*triangle->GetPoint(2));
-  front_ = new AdvancingFront(*af_head_, *af_tail_);
+  Triangle* triangle = NewTriangle(*points_[0], *head_, *tail_);
+
+  af_head_ = node_pool_.Create(*triangle->GetPoint(1), *triangle);
+  af_middle_ = node_pool_.Create(*triangle->GetPoint(0), *triangle);
+  af_tail_ = node_pool_.Create(*triangle->GetPoint(2));
+  if (front_) {
+    front_->Reset(*af_head_, *af_tail_);
+  } else {
+    front_ = new AdvancingFront(*af_head_, *af_tail_);
+  }
 
   // TODO: More intuitive if head is middles next and not previous?
   //       so swap head and tail
-  af_head_->next = af_middle_;
-  af_middle_->next = af_tail_;
-  af_middle_->prev = af_head_;
-  af_tail_->prev = af_middle_;
+  front_->InsertAfter(*af_head_, *af_middle_);
+}
+
+Node* SweepContext::NewNode(Point& point)
+{
+  return node_pool_.Create(point);
 }
 
 void SweepContext::RemoveNode(Node* node)
 {
-  delete node;
+  node_pool_.Release(node);
 }
 
 void SweepContext::MapTriangleToNodes(Triangle& t)
@@ -159,12 +575,13 @@ void SweepContext::MapTriangleToNodes(Triangle& t)
 
 void SweepContext::RemoveFromMap(Triangle* triangle)
 {
-  map_.remove(triangle);
+  map_.Remove(triangle);
 }
 
 void SweepContext::MeshClean(Triangle& triangle)
 {
-  std::vector<Triangle *> triangles;
+  std::vector<Triangle *>& triangles = mesh_clean_stack_;
+  triangles.clear();
   triangles.push_back(&triangle);
 
   while(!triangles.empty()){
@@ -173,6 +590,7 @@ void SweepContext::MeshClean(Triangle& triangle)
 
     if (t != nullptr && !t->IsInterior()) {
       t->IsInterior(true);
+      t->InteriorIndex(static_cast<std::uint32_t>(triangles_.size()));
       triangles_.push_back(t);
       for (int i = 0; i < 3; i++) {
         if (!t->constrained_edge[i])
@@ -182,25 +600,57 @@ void SweepContext::MeshClean(Triangle& triangle)
   }
 }
 
+void SweepContext::AddMemoryUsage(MemoryReport& report) const
+{
+  // The triangle and node pools hand out their slots in order, so the slots
+  // handed out are the most in use at once
+  report.triangles.live += map_.size() * sizeof(Triangle);
+  report.triangles.peak += map_.capacity() * sizeof(Triangle);
+  report.triangles.reserved += map_.reserved_bytes();
+  report.triangles.Add(triangles_);
+
+  report.nodes.live += node_pool_.size() * sizeof(Node);
+  report.nodes.peak += node_pool_.capacity() * sizeof(Node);
+  report.nodes.reserved += node_pool_.reserved_bytes();
+  if (front_) {
+    report.nodes.AddBuffer(front_->reserved_bytes());
+  }
+
+  report.edges.live += edge_pool_.size() * sizeof(Edge);
+  report.edges.peak += edge_pool_.capacity() * sizeof(Edge);
+  report.edges.reserved += edge_pool_.reserved_bytes();
+  report.edges.Add(edge_list);
+  report.edges.Add(edge_ends_);
+  report.edges.Add(edge_table_);
+  report.edges.Add(edge_offsets_);
+
+  report.points.Add(points_);
+  report.points.Add(input_points_);
+  report.points.Add(point_ranks_);
+
+  report.scratch.AddBuffer(sorter_.reserved_bytes());
+  report.scratch.AddBuffer(mesh_clean_stack_);
+  report.scratch.AddBuffer(edge_starts_);
+  report.scratch.AddBuffer(edge_interior_left_);
+  report.scratch.AddBuffer(edges_by_lower_);
+  report.scratch.AddBuffer(pending_edges_);
+  report.scratch.AddBuffer(spans_);
+  report.scratch.AddBuffer(edge_lookup_);
+  report.scratch.AddBuffer(front_x_);
+  report.scratch.AddBuffer(front_min_y_);
+  for (const auto& level : front_min_y_) {
+    report.scratch.AddBuffer(level);
+  }
+  report.scratch.AddBuffer(finished_);
+  report.scratch.AddBuffer(harvest_stack_);
+}
+
 SweepContext::~SweepContext()
 {
 
     // Clean up memory
 
-    delete head_;
-    delete tail_;
     delete front_;
-    delete af_head_;
-    delete af_middle_;
-    delete af_tail_;
-
-    for (auto ptr : map_) {
-      delete ptr;
-    }
-
-    for (auto& i : edge_list) {
-      delete i;
-    }
 }
 
 } // namespace p2t
@@ -32,7 +32,9 @@
 #pragma once
 
 #include "../poly2tri_export.h"
-#include <list>
+#include "../common/memory_usage.h"
+#include "point_sort.h"
+#include "triangle_map.h"
 #include <vector>
 #include <cstddef>
 
@@ -48,6 +50,19 @@ struct Node;
 struct Edge;
 class AdvancingFront;
 
+/**
+ * Receiver of the interior triangles of a streaming triangulation, see
+ * SweepContext::set_sink. A triangle passed to Consume is final, but its
+ * storage is reused once the sweep has moved past it, so it is only valid
+ * during the call and its neighbors must not be followed.
+ */
+class POLY2TRI_API TriangleSink {
+public:
+  virtual ~TriangleSink() {}
+
+  virtual void Consume(Triangle& triangle) = 0;
+};
+
 class POLY2TRI_API SweepContext {
 public:
 
@@ -56,6 +71,10 @@ explicit SweepContext(std::vector<Point*> polyline);
 /// Destructor
 ~SweepContext();
 
+/// Start over with a new polyline, keeping the storage of the previous
+/// triangulation for reuse
+void Reset(const std::vector<Point*>& polyline);
+
 void set_head(Point* p1);
 
 Point* head() const;
@@ -68,6 +87,10 @@ size_t point_count() const;
 
 Node* LocateNode(const Point& point);
 
+/// Create an advancing front node from the context's node pool
+Node* NewNode(Point& point);
+
+/// Return a node that has left the advancing front to the node pool
 void RemoveNode(Node* node);
 
 void CreateAdvancingFront();
@@ -75,12 +98,28 @@ void CreateAdvancingFront();
 /// Try to map a node to all sides of this triangle that don't have a neighbor
 void MapTriangleToNodes(Triangle& t);
 
-void AddToMap(Triangle* triangle);
+/// Create a triangle in the triangle map
+Triangle* NewTriangle(Point& a, Point& b, Point& c);
 
 Point* GetPoint(size_t index);
 
+/// Edges of one point, see PointEdges
+struct EdgeRange {
+  Edge* const* first;
+  Edge* const* last;
+
+  Edge* const* begin() const { return first; }
+  Edge* const* end() const { return last; }
+};
+
+/// The edges that have the point at index as their upper ending point
+EdgeRange PointEdges(size_t index) const;
+
 std::vector< Point* >& GetPoints() { return points_; }
 
+/// The points in the order they were added, as points_ is sorted
+const std::vector<Point*>& GetInputPoints() const { return input_points_; }
+
 void RemoveFromMap(Triangle* triangle);
 
 void AddHole(const std::vector<Point*>& polyline);
@@ -91,8 +130,27 @@ AdvancingFront* front() const;
 
 void MeshClean(Triangle& triangle);
 
+/// Stream the interior triangles to sink as they are finished instead of
+/// collecting them into GetTriangles, or stop streaming if sink is null
+void set_sink(TriangleSink* sink);
+TriangleSink* sink() const;
+
+/// Is a harvest due once the first processed points have been swept?
+bool HarvestDue(size_t processed) const;
+
+/// Pass the interior triangles that the sweep can no longer change, now
+/// that the first processed points have been swept, to the sink and
+/// release the triangles that are no longer needed
+void Harvest(size_t processed);
+
+/// Pass the remaining interior triangles to the sink at the end of the sweep
+void FinishStream();
+
+/// Add the memory of the context to report, by kind of structure
+void AddMemoryUsage(MemoryReport& report) const;
+
 std::vector<Triangle*> &GetTriangles();
-std::list<Triangle*> &GetMap();
+TriangleMap &GetMap();
 
 std::vector<Edge*> edge_list;
 
@@ -120,9 +178,12 @@ struct Basin {
 
 struct EdgeEvent {
   Edge* constrained_edge;
+  // Upper end of the part of constrained_edge left to insert, which moves
+  // down the edge past points that lie on it. The edge itself is left as is.
+  Point* upper;
   bool right;
 
-  EdgeEvent() : constrained_edge(NULL), right(false)
+  EdgeEvent() : constrained_edge(NULL), upper(NULL), right(false)
   {
   }
 };
@@ -132,11 +193,59 @@ EdgeEvent edge_event;
 
 private:
 
-friend class Sweep;
+template <class Kernel> friend class BasicSweep;
 
 std::vector<Triangle*> triangles_;
-std::list<Triangle*> map_;
+TriangleMap map_;
 std::vector<Point*> points_;
+std::vector<Point*> input_points_;
+// Storage for the advancing front nodes, recycled as nodes leave the front
+Pool<Node> node_pool_;
+// Storage for the edges of edge_list
+Pool<Edge> edge_pool_;
+// For each edge of edge_list, the index in input_points_ of its upper point
+std::vector<size_t> edge_ends_;
+// The edges of edge_list by upper point, those of points_[i] from
+// edge_offsets_[i] to edge_offsets_[i + 1]
+std::vector<Edge*> edge_table_;
+std::vector<size_t> edge_offsets_;
+PointSorter sorter_;
+// For each point of input_points_, its index in points_
+std::vector<size_t> point_ranks_;
+// Worklist of MeshClean
+std::vector<Triangle*> mesh_clean_stack_;
+
+// Part of a constrained edge being swept over, see Harvest
+struct EdgeSpan {
+  double xmin, xmax;
+  double px, py, qx, qy;
+  // Largest xmax of this span and the ones before it
+  double reach;
+};
+
+// Streaming state, see Harvest
+TriangleSink* sink_;
+size_t next_harvest_;
+double last_sweep_y_;
+// For each edge of edge_list, the index in input_points_ of its lower point
+std::vector<size_t> edge_starts_;
+// For each edge of edge_list, is the inside of the polygon left of p->q?
+std::vector<unsigned char> edge_interior_left_;
+// The edges of edge_list by lower point and the next one to reach
+std::vector<size_t> edges_by_lower_;
+size_t lower_cursor_;
+// Edges with their lower point swept and their upper point not
+std::vector<size_t> pending_edges_;
+std::vector<EdgeSpan> spans_;
+// Open addressing table of the edges by their two points
+std::vector<size_t> edge_lookup_;
+int edge_lookup_shift_;
+// Front points by x, with a sparse table of their minimum y over ranges
+std::vector<double> front_x_;
+std::vector<std::vector<double>> front_min_y_;
+// Triangles the sweep is done with, waiting to be classified or released
+std::vector<Triangle*> finished_;
+std::vector<Triangle*> harvest_stack_;
 
 // Advancing front
 AdvancingFront* front_;
@@ -144,11 +253,33 @@ AdvancingFront* front_;
 Point* head_;
 // tail point used with advancing front
 Point* tail_;
+// Storage of the sentinel points
+Point head_point_, tail_point_;
 
 Node *af_head_, *af_middle_, *af_tail_;
 
-void InitTriangulation();
-void InitEdges(const std::vector<Point*>& polyline);
+/// Sort the points and place the sentinels, on integral coordinates if asked to
+void InitTriangulation(bool integral_sentinels);
+/// Add the edges of a polyline whose first point will be input point first_index,
+/// the polygon outline or one of its holes
+void InitEdges(const std::vector<Point*>& polyline, size_t first_index, bool hole);
+/// Sort edge_list into edge_table_ by upper point
+void InitEdgeTable();
+/// Set up the streaming state once the points are sorted
+void InitStream();
+/// Index in edge_list of the edge between a and b, or edge_list.size()
+size_t FindEdge(const Point* a, const Point* b) const;
+/// Is the sweep, up to sweep_y, done changing t? If it will not be for a
+/// while, going by the advance since the last harvest, t is told to wait.
+bool IsSettled(Triangle& t, double sweep_y, double advance) const;
+/// Is t inside the polygon, going by one of its constrained edges? Only
+/// known if one is an edge of edge_list rather than part of one.
+bool SideOfConstraint(Triangle& t, bool& interior) const;
+/// Is the point inside the polygon? Counts the edges crossed by a ray to
+/// its left, which must all have their lower point swept.
+bool IsInside(double x, double y) const;
+/// Classify the finished triangles and pass the interior ones on
+void Classify();
 
 };
 
@@ -157,6 +288,22 @@ inline AdvancingFront* SweepContext::front() const
   return front_;
 }
 
+inline TriangleSink* SweepContext::sink() const
+{
+  return sink_;
+}
+
+inline bool SweepContext::HarvestDue(size_t processed) const
+{
+  return sink_ && processed >= next_harvest_;
+}
+
+inline SweepContext::EdgeRange SweepContext::PointEdges(size_t index) const
+{
+  return EdgeRange{ edge_table_.data() + edge_offsets_[index],
+                    edge_table_.data() + edge_offsets_[index + 1] };
+}
+
 inline size_t SweepContext::point_count() const
 {
   return points_.size();
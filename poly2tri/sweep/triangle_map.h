@@ -0,0 +1,166 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "../common/arena.h"
+#include "../common/shapes.h"
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace p2t {
+
+/**
+ * Contiguous store of every triangle created during a triangulation.
+ *
+ * Triangles live in an arena in creation order. Removing a triangle clears it and puts
+ * its slot on a free list, so removal is O(1) and the slot is reused by the next
+ * triangle created. Iteration walks the arena in memory order and skips cleared slots.
+ */
+class TriangleMap {
+public:
+  class iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Triangle*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Triangle**;
+    using reference = Triangle*;
+
+    iterator(const Arena<Triangle>& arena, std::size_t index) : arena_(&arena), index_(index)
+    {
+      SkipRemoved();
+    }
+
+    // Read only is the map, not its triangles, as with the vector of
+    // CDT::GetTriangles
+    Triangle* operator*() const
+    {
+      return const_cast<Triangle*>(&(*arena_)[index_]);
+    }
+
+    iterator& operator++()
+    {
+      ++index_;
+      SkipRemoved();
+      return *this;
+    }
+
+    iterator operator++(int)
+    {
+      iterator it = *this;
+      ++*this;
+      return it;
+    }
+
+    bool operator==(const iterator& other) const
+    {
+      return index_ == other.index_;
+    }
+
+    bool operator!=(const iterator& other) const
+    {
+      return index_ != other.index_;
+    }
+
+  private:
+    void SkipRemoved()
+    {
+      while (index_ < arena_->size() && (**this)->GetPoint(0) == nullptr) {
+        ++index_;
+      }
+    }
+
+    const Arena<Triangle>* arena_;
+    std::size_t index_;
+  };
+
+  /// Create a triangle, reusing the slot of a removed triangle if there is one
+  Triangle* Create(Point& a, Point& b, Point& c)
+  {
+    if (free_.empty()) {
+      return arena_.Create(a, b, c);
+    }
+    Triangle* triangle = free_.back();
+    free_.pop_back();
+    return new (triangle) Triangle(a, b, c);
+  }
+
+  /// Detach a triangle from its neighbors and release its slot
+  void Remove(Triangle* triangle)
+  {
+    triangle->Clear();
+    free_.push_back(triangle);
+  }
+
+  /// Remove every triangle, keeping the memory for the next triangulation
+  void Clear()
+  {
+    arena_.Clear();
+    free_.clear();
+  }
+
+  /// Number of triangles in the map
+  std::size_t size() const
+  {
+    return arena_.size() - free_.size();
+  }
+
+  /// Number of slots ever handed out since Clear; the map's high-water mark
+  std::size_t capacity() const
+  {
+    return arena_.size();
+  }
+
+  /// Bytes obtained from the allocator, including the free list
+  std::size_t reserved_bytes() const
+  {
+    return arena_.reserved_bytes() + free_.capacity() * sizeof(Triangle*);
+  }
+
+  iterator begin() const
+  {
+    return iterator(arena_, 0);
+  }
+
+  iterator end() const
+  {
+    return iterator(arena_, arena_.size());
+  }
+
+private:
+  Arena<Triangle> arena_;
+  std::vector<Triangle*> free_;
+};
+
+} // namespace p2t
@@ -0,0 +1,184 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Input of the testbed and of the headless benchmark driver, bench/p2t_bench.cc:
+// the .dat file parser and the random point generator.
+
+#pragma once
+
+#include <poly2tri/poly2tri.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+inline double StringToDouble(const std::string& s)
+{
+  std::istringstream i(s);
+  double x;
+  if (!(i >> x))
+    return 0;
+  return x;
+}
+
+/// Parse a .dat file: the polyline, then optional HOLE and STEINER sections
+inline bool ParseFile(const std::string& filename, std::vector<p2t::Point*>& out_polyline,
+                      std::vector<std::vector<p2t::Point*>>& out_holes,
+                      std::vector<p2t::Point*>& out_steiner)
+{
+  enum ParserState {
+    Polyline,
+    Hole,
+    Steiner,
+  };
+  ParserState state = Polyline;
+  std::vector<p2t::Point*>* hole = nullptr;
+  try {
+    std::string line;
+    std::ifstream myfile(filename);
+    if (myfile.is_open()) {
+      while (!myfile.eof()) {
+        getline(myfile, line);
+        if (line.empty()) {
+          break;
+        }
+        std::istringstream iss(line);
+        std::vector<std::string> tokens;
+        copy(std::istream_iterator<std::string>(iss), std::istream_iterator<std::string>(),
+             back_inserter(tokens));
+        if (tokens.empty()) {
+          break;
+        } else if (tokens.size() == 1u) {
+          const auto token = tokens[0];
+          if (token == "HOLE") {
+            state = Hole;
+            out_holes.emplace_back();
+            hole = &out_holes.back();
+          } else if (token == "STEINER") {
+            state = Steiner;
+          } else {
+            throw std::runtime_error("Invalid token [" + token + "]");
+          }
+        } else {
+          double x = StringToDouble(tokens[0]);
+          double y = StringToDouble(tokens[1]);
+          switch (state) {
+            case Polyline:
+              out_polyline.push_back(new p2t::Point(x, y));
+              break;
+            case Hole:
+              assert(hole != nullptr);
+              hole->push_back(new p2t::Point(x, y));
+              break;
+            case Steiner:
+              out_steiner.push_back(new p2t::Point(x, y));
+              break;
+            default:
+              assert(0);
+          }
+        }
+      }
+    } else {
+      throw std::runtime_error("File not opened");
+    }
+  } catch (std::exception& e) {
+    std::cerr << "Error parsing file: " << e.what() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+inline double Fun(double x)
+{
+  return 2.5 + sin(10 * x) / x;
+}
+
+/**
+ * A random value in [xmin, xmax] distributed as fun, by rejection against its
+ * maximum. The maximum is sampled once per function, at 2^20 points. Draws
+ * from rand(), seed it with srand first.
+ */
+inline double Random(double (*fun)(double), double xmin = 0, double xmax = 1)
+{
+  static double (*Fun)(double) = NULL, YMin, YMax;
+  const int samples = 1 << 20;
+
+  // Evaluates maximum of function
+  if (fun != Fun)
+  {
+    Fun = fun;
+    YMin = 0, YMax = Fun(xmin);
+    for (int iX = 1; iX < samples; iX++)
+    {
+      double X = xmin + (xmax - xmin) * iX / samples;
+      double Y = Fun(X);
+      YMax = Y > YMax ? Y : YMax;
+    }
+  }
+
+  // Gets random values for X & Y, until they are valid
+  for (;;) {
+    double X = xmin + (xmax - xmin) * rand() / RAND_MAX;
+    double Y = YMin + (YMax - YMin) * rand() / RAND_MAX;
+    if (Y < fun(X)) {
+      return X;
+    }
+  }
+}
+
+/// The square [min, max]^2 with num_points Steiner points in it, each coordinate distributed as Fun
+inline void GenerateRandomPointDistribution(size_t num_points, double min, double max,
+                                            std::vector<p2t::Point*>& out_polyline,
+                                            std::vector<std::vector<p2t::Point*>>& /* out_holes */,
+                                            std::vector<p2t::Point*>& out_steiner)
+{
+  out_polyline.push_back(new p2t::Point(min, min));
+  out_polyline.push_back(new p2t::Point(min, max));
+  out_polyline.push_back(new p2t::Point(max, max));
+  out_polyline.push_back(new p2t::Point(max, min));
+
+  max -= (1e-4);
+  min += (1e-4);
+  for (size_t i = 0; i < num_points; i++) {
+    double x = Random(Fun, min, max);
+    double y = Random(Fun, min, max);
+    out_steiner.push_back(new p2t::Point(x, y));
+  }
+}
@@ -28,6 +28,8 @@
  * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
+#include "input.h"
+
 #include <poly2tri/poly2tri.h>
 
 #include <GLFW/glfw3.h>
@@ -41,7 +43,6 @@
 #include <iostream>
 #include <iterator>
 #include <limits>
-#include <list>
 #include <numeric>
 #include <sstream>
 #include <string>
@@ -51,22 +52,13 @@
 using namespace std;
 using namespace p2t;
 
-bool ParseFile(string filename, vector<Point*>& out_polyline, vector<vector<Point*>>& out_holes,
-               vector<Point*>& out_steiner);
 std::pair<Point, Point> BoundingBox(const std::vector<Point*>& polyline);
-void GenerateRandomPointDistribution(size_t num_points, double min, double max,
-                                     vector<Point*>& out_polyline,
-                                     vector<vector<Point*>>& out_holes,
-                                     vector<Point*>& out_steiner);
 void Init(int window_width, int window_height);
 void ShutDown(int return_code);
 void MainLoop(const double zoom);
 void Draw(const double zoom);
 void DrawMap(const double zoom);
 void ConstrainedColor(bool constrain);
-double StringToDouble(const std::string& s);
-double Random(double (*fun)(double), double xmin, double xmax);
-double Fun(double x);
 
 double rotate_y = 0.0,
        rotate_z = 0.0;
@@ -87,7 +79,7 @@ double cy = 0.0;
 /// Constrained triangles
 vector<Triangle*> triangles;
 /// Triangle map
-list<Triangle*> map;
+const TriangleMap* map = nullptr;
 /// Polylines
 vector<Point*> polyline;
 vector<vector<Point*>> holes;
@@ -147,6 +139,7 @@ int main(int argc, char* argv[])
   }
 
   if (random_distribution) {
+    srand(static_cast<unsigned>(time(NULL)));
     GenerateRandomPointDistribution(num_points, min, max, polyline, holes, steiner);
   } else {
     // Load pointset from file
@@ -203,7 +196,7 @@ int main(int argc, char* argv[])
   double dt = glfwGetTime() - init_time;
 
   triangles = cdt->GetTriangles();
-  map = cdt->GetMap();
+  map = &cdt->GetMap();
   const size_t points_in_holes =
       std::accumulate(holes.cbegin(), holes.cend(), size_t(0),
                       [](size_t cumul, const vector<Point*>& hole) { return cumul + hole.size(); });
@@ -232,70 +225,6 @@ int main(int argc, char* argv[])
   return 0;
 }
 
-bool ParseFile(string filename, vector<Point*>& out_polyline, vector<vector<Point*>>& out_holes,
-               vector<Point*>& out_steiner)
-{
-  enum ParserState {
-    Polyline,
-    Hole,
-    Steiner,
-  };
-  ParserState state = Polyline;
-  vector<Point*>* hole = nullptr;
-  try {
-    string line;
-    ifstream myfile(filename);
-    if (myfile.is_open()) {
-      while (!myfile.eof()) {
-        getline(myfile, line);
-        if (line.empty()) {
-          break;
-        }
-        istringstream iss(line);
-        vector<string> tokens;
-        copy(istream_iterator<string>(iss), istream_iterator<string>(), back_inserter(tokens));
-        if (tokens.empty()) {
-          break;
-        } else if (tokens.size() == 1u) {
-          const auto token = tokens[0];
-          if (token == "HOLE") {
-            state = Hole;
-            out_holes.emplace_back();
-            hole = &out_holes.back();
-          } else if (token == "STEINER") {
-            state = Steiner;
-          } else {
-            throw runtime_error("Invalid token [" + token + "]");
-          }
-        } else {
-          double x = StringToDouble(tokens[0]);
-          double y = StringToDouble(tokens[1]);
-          switch (state) {
-            case Polyline:
-              out_polyline.push_back(new Point(x, y));
-              break;
-            case Hole:
-              assert(hole != nullptr);
-              hole->push_back(new Point(x, y));
-              break;
-            case Steiner:
-              out_steiner.push_back(new Point(x, y));
-              break;
-            default:
-              assert(0);
-          }
-        }
-      }
-    } else {
-      throw runtime_error("File not opened");
-    }
-  } catch (exception& e) {
-    cerr << "Error parsing file: " << e.what() << endl;
-    return false;
-  }
-  return true;
-}
-
 std::pair<Point, Point> BoundingBox(const std::vector<Point*>& polyline)
 {
   assert(polyline.size() > 0);
@@ -311,24 +240,6 @@ std::pair<Point, Point> BoundingBox(const std::vector<Point*>& polyline)
   return std::make_pair(min, max);
 }
 
-void GenerateRandomPointDistribution(size_t num_points, double min, double max,
-                                     vector<Point*>& out_polyline,
-                                     vector<vector<Point*>>& out_holes, vector<Point*>& out_steiner)
-{
-  out_polyline.push_back(new Point(min, min));
-  out_polyline.push_back(new Point(min, max));
-  out_polyline.push_back(new Point(max, max));
-  out_polyline.push_back(new Point(max, min));
-
-  max -= (1e-4);
-  min += (1e-4);
-  for (int i = 0; i < num_points; i++) {
-    double x = Random(Fun, min, max);
-    double y = Random(Fun, min, max);
-    out_steiner.push_back(new Point(x, y));
-  }
-}
-
 void Init(int window_width, int window_height)
 {
   if (glfwInit() != GL_TRUE)
@@ -462,9 +373,8 @@ void DrawMap(const double zoom)
 
   ResetZoom(zoom, center.x, center.y, (double)default_window_width, (double)default_window_height);
 
-  list<Triangle*>::iterator it;
-  for (it = map.begin(); it != map.end(); it++) {
-    Triangle& t = **it;
+  for (Triangle* triangle : *map) {
+    Triangle& t = *triangle;
     Point& a = *t.GetPoint(0);
     Point& b = *t.GetPoint(1);
     Point& c = *t.GetPoint(2);
@@ -499,50 +409,3 @@ void ConstrainedColor(bool constrain)
     glColor3f(1, 0, 0);
   }
 }
-
-double StringToDouble(const std::string& s)
-{
-  std::istringstream i(s);
-  double x;
-  if (!(i >> x))
-    return 0;
-  return x;
-}
-
-double Fun(double x)
-{
-  return 2.5 + sin(10 * x) / x;
-}
-
-double Random(double (*fun)(double), double xmin = 0, double xmax = 1)
-{
-  static double (*Fun)(double) = NULL, YMin, YMax;
-  static bool First = true;
-
-  // Initialises random generator for first call
-  if (First)
-  {
-    First = false;
-    srand((unsigned) time(NULL));
-  }
-
-  // Evaluates maximum of function
-  if (fun != Fun)
-  {
-    Fun = fun;
-    YMin = 0, YMax = Fun(xmin);
-    for (int iX = 1; iX < RAND_MAX; iX++)
-    {
-      double X = xmin + (xmax - xmin) * iX / RAND_MAX;
-      double Y = Fun(X);
-      YMax = Y > YMax ? Y : YMax;
-    }
-  }
-
-  // Gets random values for X & Y
-  double X = xmin + (xmax - xmin) * rand() / RAND_MAX;
-  double Y = YMin + (YMax - YMin) * rand() / RAND_MAX;
-
-  // Returns if valid and try again if not valid
-  return Y < fun(X) ? X : Random(Fun, xmin, xmax);
-}
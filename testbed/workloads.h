@@ -0,0 +1,384 @@
+/*
+ * Poly2Tri Copyright (c) 2009-2022, Poly2Tri Contributors
+ * https://github.com/jhasse/poly2tri
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of Poly2Tri nor the names of its contributors may be
+ *   used to endorse or promote products derived from this software without specific
+ *   prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Named, seeded workloads for the benchmarks and the unit tests, each built to
+// load one part of the sweep: long front walks, deep flip cascades, many holes
+// or many points on and near one line. The same seed gives the same polygon,
+// as the random numbers are drawn from std::mt19937_64 alone.
+
+#pragma once
+
+#include <poly2tri/poly2tri.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace workload {
+
+/// A polygon with holes and Steiner points, holding its points
+struct Polygon {
+  std::vector<p2t::Point> outline;
+  std::vector<std::vector<p2t::Point>> holes;
+  std::vector<p2t::Point> steiner;
+
+  std::size_t size() const
+  {
+    std::size_t n = outline.size() + steiner.size();
+    for (auto& hole : holes) {
+      n += hole.size();
+    }
+    return n;
+  }
+};
+
+/// Pointers to points, as CDT takes them
+inline std::vector<p2t::Point*> Pointers(std::vector<p2t::Point>& points)
+{
+  std::vector<p2t::Point*> pointers;
+  pointers.reserve(points.size());
+  for (auto& p : points) {
+    pointers.push_back(&p);
+  }
+  return pointers;
+}
+
+/// Add the holes and Steiner points of a polygon to a CDT made with its outline
+template <class CDT>
+void AddTo(CDT& cdt, Polygon& polygon)
+{
+  for (auto& hole : polygon.holes) {
+    cdt.AddHole(Pointers(hole));
+  }
+  for (auto& p : polygon.steiner) {
+    cdt.AddPoint(&p);
+  }
+}
+
+/**
+ * Random numbers that are the same everywhere: std::mt19937_64 is specified
+ * to the bit, where the standard distributions are not. Gaussian goes through
+ * std::log and std::cos, and so may differ in the last bits between math
+ * libraries.
+ */
+class Rng {
+public:
+  explicit Rng(std::uint64_t seed) : engine_(seed) {}
+
+  /// Uniform in [0, 1)
+  double Uniform() { return static_cast<double>(engine_() >> 11) * (1.0 / 9007199254740992.0); }
+
+  /// Uniform in [a, b)
+  double Uniform(double a, double b) { return a + (b - a) * Uniform(); }
+
+  /// Normally distributed with mean 0 and deviation 1, by Box-Muller
+  double Gaussian()
+  {
+    if (has_spare_) {
+      has_spare_ = false;
+      return spare_;
+    }
+    const double pi = 3.14159265358979323846;
+    const double r = std::sqrt(-2.0 * std::log(1.0 - Uniform()));
+    const double angle = 2.0 * pi * Uniform();
+    spare_ = r * std::sin(angle);
+    has_spare_ = true;
+    return r * std::cos(angle);
+  }
+
+private:
+  std::mt19937_64 engine_;
+  double spare_ = 0.0;
+  bool has_spare_ = false;
+};
+
+/// The square [min, max]^2, counterclockwise
+inline std::vector<p2t::Point> Square(double min, double max)
+{
+  return { { min, min }, { max, min }, { max, max }, { min, max } };
+}
+
+/**
+ * The square [-1, 1]^2 with uniformly distributed Steiner points, as the
+ * testbed's random input but for their distribution
+ */
+inline Polygon Uniform(std::size_t num_points, std::uint64_t seed)
+{
+  Rng rng(seed);
+  Polygon polygon;
+  polygon.outline = Square(-1, 1);
+  polygon.steiner.reserve(num_points);
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const double x = rng.Uniform(-0.999, 0.999);
+    polygon.steiner.emplace_back(x, rng.Uniform(-0.999, 0.999));
+  }
+  return polygon;
+}
+
+/**
+ * A comb of num_points / 4 teeth of unit width and random height, as tall as
+ * the comb is wide. The front grows a node per tooth and the long sides of
+ * the teeth make long edge events.
+ */
+inline Polygon Comb(std::size_t num_points, std::uint64_t seed)
+{
+  Rng rng(seed);
+  const std::size_t teeth = std::max<std::size_t>(2, num_points / 4);
+  const double height = 2.0 * teeth;
+  Polygon polygon;
+  auto& outline = polygon.outline;
+  outline.reserve(4 * teeth);
+  outline.emplace_back(0, 0);
+  outline.emplace_back(2.0 * teeth - 1, 0);
+  for (std::size_t k = teeth; k-- > 0;) {
+    const double top = 1 + height * rng.Uniform(0.5, 1.0);
+    outline.emplace_back(2.0 * k + 1, top);
+    outline.emplace_back(2.0 * k, top);
+    if (k > 0) {
+      outline.emplace_back(2.0 * k, 1);
+      outline.emplace_back(2.0 * k - 1, 1);
+    }
+  }
+  return polygon;
+}
+
+/**
+ * A channel half a unit wide wound into an Archimedean spiral with turns a
+ * unit apart, its sides jittered by up to 0.05. The front has to go around
+ * every turn. Turns are sampled densely enough that no side comes within
+ * 0.2 of the next.
+ */
+inline Polygon Spiral(std::size_t num_points, std::uint64_t seed)
+{
+  Rng rng(seed);
+  const double pi = 3.14159265358979323846;
+  const std::size_t per_side = std::max<std::size_t>(64, num_points / 2);
+  // Samples per turn grow with the radius, as 10 sqrt(turns), to keep each
+  // side's chords within 0.05 of its curve
+  const double turns = std::max(2.0, std::pow(per_side / 10.0, 2.0 / 3.0));
+  const double phase = rng.Uniform(0, 2 * pi);
+  Polygon polygon;
+  auto& outline = polygon.outline;
+  outline.resize(2 * per_side);
+  for (std::size_t i = 0; i < per_side; ++i) {
+    const double angle = 2 * pi * (1 + turns * i / (per_side - 1));
+    const double r = angle / (2 * pi);
+    const double inner = r + rng.Uniform(-0.05, 0.05);
+    const double outer = r + 0.5 + rng.Uniform(-0.05, 0.05);
+    const double c = std::cos(angle + phase), s = std::sin(angle + phase);
+    outline[i] = p2t::Point(inner * c, inner * s);
+    outline[2 * per_side - 1 - i] = p2t::Point(outer * c, outer * s);
+  }
+  return polygon;
+}
+
+/**
+ * A Koch snowflake subdivided until it has about num_points corners, at most
+ * 3 * 4^10. Its bumps are between 0.6 and 1 times the height of the usual
+ * ones and the whole is turned, both by the seed. Legalization flips deep
+ * through its many small, nearly cocircular triangles.
+ */
+inline Polygon Koch(std::size_t num_points, std::uint64_t seed)
+{
+  Rng rng(seed);
+  const double pi = 3.14159265358979323846;
+  const double bump = rng.Uniform(0.6, 1.0) * std::sqrt(3.0) / 6;
+  const double turn = rng.Uniform(0, 2 * pi);
+  std::vector<p2t::Point> outline;
+  for (int k = 0; k < 3; ++k) {
+    const double angle = turn + 2 * pi * k / 3;
+    outline.emplace_back(std::cos(angle), std::sin(angle));
+  }
+  for (int depth = 0; depth < 10 && outline.size() * 4 <= 2 * std::max<std::size_t>(num_points, 3);
+       ++depth) {
+    std::vector<p2t::Point> next;
+    next.reserve(4 * outline.size());
+    for (std::size_t i = 0; i < outline.size(); ++i) {
+      const p2t::Point& a = outline[i];
+      const p2t::Point& b = outline[(i + 1) % outline.size()];
+      const double dx = b.x - a.x, dy = b.y - a.y;
+      // The outside of the counterclockwise outline is to the right
+      next.push_back(a);
+      next.emplace_back(a.x + dx / 3, a.y + dy / 3);
+      next.emplace_back(a.x + dx / 2 + bump * dy, a.y + dy / 2 - bump * dx);
+      next.emplace_back(a.x + 2 * dx / 3, a.y + 2 * dy / 3);
+    }
+    outline.swap(next);
+  }
+  Polygon polygon;
+  polygon.outline = std::move(outline);
+  return polygon;
+}
+
+/// The square [-1, 1]^2 with Steiner points normally distributed about its center
+inline Polygon GaussianCloud(std::size_t num_points, std::uint64_t seed)
+{
+  Rng rng(seed);
+  Polygon polygon;
+  polygon.outline = Square(-1, 1);
+  polygon.steiner.reserve(num_points);
+  while (polygon.steiner.size() < num_points) {
+    const double x = 0.25 * rng.Gaussian(), y = 0.25 * rng.Gaussian();
+    if (std::fabs(x) < 0.999 && std::fabs(y) < 0.999) {
+      polygon.steiner.emplace_back(x, y);
+    }
+  }
+  return polygon;
+}
+
+/**
+ * The square [-1, 1]^2 with Steiner points normally distributed about
+ * num_clusters centers, with the given deviation, taking turns
+ */
+inline Polygon Clusters(std::size_t num_points, std::uint64_t seed, std::size_t num_clusters,
+                        double deviation)
+{
+  Rng rng(seed);
+  std::vector<p2t::Point> centers(std::max<std::size_t>(1, num_clusters));
+  for (auto& center : centers) {
+    center.x = rng.Uniform(-0.9, 0.9);
+    center.y = rng.Uniform(-0.9, 0.9);
+  }
+  Polygon polygon;
+  polygon.outline = Square(-1, 1);
+  polygon.steiner.reserve(num_points);
+  while (polygon.steiner.size() < num_points) {
+    const p2t::Point& center = centers[polygon.steiner.size() % centers.size()];
+    const double x = center.x + deviation * rng.Gaussian();
+    const double y = center.y + deviation * rng.Gaussian();
+    if (std::fabs(x) < 0.999 && std::fabs(y) < 0.999) {
+      polygon.steiner.emplace_back(x, y);
+    }
+  }
+  return polygon;
+}
+
+/**
+ * The square [-1, 1]^2 with Steiner points in tight clusters of about a
+ * thousand: the sweep crosses long stretches of few points, then a great
+ * many at once.
+ */
+inline Polygon ClusteredCloud(std::size_t num_points, std::uint64_t seed)
+{
+  return Clusters(num_points, seed, num_points / 1000, 0.01);
+}
+
+/**
+ * A square holding num_points / 4 tiny square holes, one in each cell of a
+ * grid, with random size, place in the cell and angle
+ */
+inline Polygon TinyHoles(std::size_t num_points, std::uint64_t seed)
+{
+  Rng rng(seed);
+  const double pi = 3.14159265358979323846;
+  const std::size_t num_holes = std::max<std::size_t>(1, num_points / 4);
+  const std::size_t side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(num_holes))));
+  Polygon polygon;
+  polygon.outline = Square(0, static_cast<double>(side));
+  polygon.holes.reserve(num_holes);
+  for (std::size_t k = 0; k < num_holes; ++k) {
+    const double cx = k % side + 0.5 + rng.Uniform(-0.3, 0.3);
+    const double cy = k / side + 0.5 + rng.Uniform(-0.3, 0.3);
+    const double r = rng.Uniform(0.01, 0.05);
+    const double angle = rng.Uniform(0, pi / 2);
+    std::vector<p2t::Point> hole;
+    for (int i = 0; i < 4; ++i) {
+      hole.emplace_back(cx + r * std::cos(angle + i * pi / 2), cy + r * std::sin(angle + i * pi / 2));
+    }
+    polygon.holes.push_back(std::move(hole));
+  }
+  return polygon;
+}
+
+/**
+ * A square grid of Steiner points, each coordinate moved by up to about a
+ * unit in the last place. Many incircle tests are too close to zero for the
+ * floating point filter, and go to exact arithmetic.
+ */
+inline Polygon NearCollinearGrid(std::size_t num_points, std::uint64_t seed)
+{
+  Rng rng(seed);
+  const std::size_t side = std::max<std::size_t>(
+      2, static_cast<std::size_t>(std::sqrt(static_cast<double>(num_points))));
+  Polygon polygon;
+  polygon.outline = Square(-1, static_cast<double>(side));
+  polygon.steiner.reserve(side * side);
+  const double ulp = std::numeric_limits<double>::epsilon();
+  for (std::size_t i = 0; i < side; ++i) {
+    for (std::size_t j = 0; j < side; ++j) {
+      const double x = i + rng.Uniform(-ulp, ulp) * std::max<std::size_t>(i, 1);
+      polygon.steiner.emplace_back(x, j + rng.Uniform(-ulp, ulp) * std::max<std::size_t>(j, 1));
+    }
+  }
+  return polygon;
+}
+
+/// A generator, by the name benchmarks and tests know it by
+struct Workload {
+  const char* name;
+  /// The part of the sweep it loads
+  const char* loads;
+  /// Makes a polygon of about num_points points
+  Polygon (*make)(std::size_t num_points, std::uint64_t seed);
+};
+
+inline const std::vector<Workload>& Workloads()
+{
+  static const std::vector<Workload> workloads = {
+    { "uniform", "baseline", Uniform },
+    { "comb", "front walks, long edge events", Comb },
+    { "spiral", "front walks around a long channel", Spiral },
+    { "koch", "flip cascades", Koch },
+    { "gaussian", "uneven point density", GaussianCloud },
+    { "clusters", "front fill in dense clusters", ClusteredCloud },
+    { "tiny_holes", "many holes", TinyHoles },
+    { "near_collinear", "exact predicates", NearCollinearGrid },
+  };
+  return workloads;
+}
+
+/// The workload of that name, or nullptr
+inline const Workload* FindWorkload(const std::string& name)
+{
+  for (const Workload& workload : Workloads()) {
+    if (name == workload.name) {
+      return &workload;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace workload
@@ -0,0 +1,77 @@
+#if !defined(_WIN32) && !defined(BOOST_TEST_DYN_LINK)
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <poly2tri/sweep/advancing_front.h>
+
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(AdvancingFrontSearchTest)
+{
+  const int n = 500;
+  std::vector<p2t::Point> points;
+  for (int i = 0; i < n; ++i) {
+    points.emplace_back(i / 2, 0); // pairs of nodes share an x value
+  }
+  std::vector<p2t::Node> nodes(points.begin(), points.end());
+  p2t::AdvancingFront front(nodes.front(), nodes.back());
+  for (int i = 1; i < n - 1; ++i) {
+    front.InsertAfter(nodes[i - 1], nodes[i]);
+  }
+  BOOST_CHECK_EQUAL(front.size(), static_cast<size_t>(n));
+
+  // Remove a random half of the inner nodes
+  std::mt19937 rng(1);
+  std::vector<bool> live(n, true);
+  for (int i = 0; i < n; ++i) {
+    const int k = 1 + static_cast<int>(rng() % (n - 2));
+    if (live[k]) {
+      front.Remove(nodes[k]);
+      live[k] = false;
+    }
+  }
+
+  for (double x = 0; x < n / 2 - 1; x += 0.25) {
+    const p2t::Node* expected = nullptr;
+    for (const p2t::Node* node = front.head(); node && node->value <= x; node = node->next) {
+      expected = node;
+    }
+    BOOST_CHECK_EQUAL(front.LocateNode(x), expected);
+  }
+  for (int i = 0; i < n; ++i) {
+    BOOST_CHECK_EQUAL(front.LocatePoint(&points[i]), live[i] ? &nodes[i] : nullptr);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AdvancingFrontPointLookupTest)
+{
+  // Churn the front the way the sweep does: nodes come and go while the
+  // front stays small, so the point table sees many removals
+  const int n = 2000;
+  std::vector<p2t::Point> points;
+  for (int i = 0; i < n; ++i) {
+    points.emplace_back(i, 0);
+  }
+  std::vector<p2t::Node> nodes(points.begin(), points.end());
+  p2t::AdvancingFront front(nodes.front(), nodes.back());
+
+  std::mt19937 rng(2);
+  std::vector<bool> live(n, false);
+  live.front() = live.back() = true;
+  for (int i = 1; i < n - 1; ++i) {
+    front.InsertAfter(*front.LocateNode(i), nodes[i]);
+    live[i] = true;
+    const int k = 1 + static_cast<int>(rng() % i);
+    if (live[k] && rng() % 4 != 0) {
+      front.Remove(nodes[k]);
+      live[k] = false;
+    }
+  }
+
+  for (int i = 0; i < n; ++i) {
+    BOOST_CHECK_EQUAL(front.LocatePoint(&points[i]), live[i] ? &nodes[i] : nullptr);
+  }
+  const p2t::Point stranger(n / 2, 0);
+  BOOST_CHECK(front.LocatePoint(&stranger) == nullptr);
+}
@@ -0,0 +1,99 @@
+#if !defined(_WIN32) && !defined(BOOST_TEST_DYN_LINK)
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <poly2tri/poly2tri.h>
+
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+// The front filling heuristics as they were decided with atan2
+
+double Atan2Angle(const p2t::Point& origin, const p2t::Point& pa, const p2t::Point& pb)
+{
+  double cross, dot;
+  p2t::AngleCrossDot(origin, pa, pb, cross, dot);
+  return std::atan2(cross, dot);
+}
+
+void CheckAngles(const p2t::Point& origin, const p2t::Point& pa, const p2t::Point& pb)
+{
+  const double angle = Atan2Angle(origin, pa, pb);
+  BOOST_CHECK_EQUAL(p2t::AngleIsNegative(origin, pa, pb), angle < 0);
+  BOOST_CHECK_EQUAL(p2t::AngleExceeds90Degrees(origin, pa, pb), angle > p2t::PI_div2 || angle < -p2t::PI_div2);
+  BOOST_CHECK_EQUAL(p2t::AngleExceedsPlus90DegreesOrIsNegative(origin, pa, pb),
+                    angle > p2t::PI_div2 || angle < 0);
+}
+
+void CheckDirection(double x, double y)
+{
+  BOOST_CHECK_EQUAL(p2t::DirectionExceeds135Degrees(x, y), std::atan2(y, x) >= p2t::PI_3div4);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(AngleLatticeTest)
+{
+  // Covers the axes, the diagonals and both signed zeros
+  const double zeros[] = { 0.0, -0.0 };
+  for (int ax = -6; ax <= 6; ++ax) {
+    for (int ay = -6; ay <= 6; ++ay) {
+      for (double z : zeros) {
+        const double x = ax == 0 ? z : ax;
+        const double y = ay == 0 ? z : ay;
+        CheckDirection(x, y);
+        for (int bx = -3; bx <= 3; ++bx) {
+          for (int by = -3; by <= 3; ++by) {
+            CheckAngles(p2t::Point(0, 0), p2t::Point(x, y), p2t::Point(bx, by));
+          }
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AngleRandomTest)
+{
+  std::mt19937_64 rng(11);
+  std::uniform_real_distribution<double> coord(-1e3, 1e3);
+  for (int i = 0; i < 100000; ++i) {
+    const p2t::Point origin(coord(rng), coord(rng));
+    const p2t::Point pa(coord(rng), coord(rng));
+    const p2t::Point pb(coord(rng), coord(rng));
+    CheckAngles(origin, pa, pb);
+    CheckDirection(pa.x - origin.x, pa.y - origin.y);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AngleTestbedTest)
+{
+  // Consecutive points of the test polygons, as they meet on the front
+#ifndef P2T_BASE_DIR
+  const auto basedir = boost::filesystem::path(__FILE__).remove_filename().parent_path();
+#else
+  const auto basedir = boost::filesystem::path(P2T_BASE_DIR);
+#endif
+  for (const auto& entry : boost::filesystem::directory_iterator(basedir / "testbed/data")) {
+    std::ifstream file(entry.path().string());
+    std::vector<p2t::Point> points;
+    std::string line;
+    while (std::getline(file, line)) {
+      std::istringstream iss(line);
+      double x, y;
+      if (iss >> x >> y) {
+        points.emplace_back(x, y);
+      }
+    }
+    for (size_t i = 2; i < points.size(); ++i) {
+      CheckAngles(points[i - 1], points[i], points[i - 2]);
+      CheckAngles(points[i - 1], points[i - 2], points[i]);
+      CheckDirection(points[i - 2].x - points[i].x, points[i - 2].y - points[i].y);
+    }
+  }
+}
@@ -0,0 +1,123 @@
+#if !defined(_WIN32) && !defined(BOOST_TEST_DYN_LINK)
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <poly2tri/poly2tri.h>
+#include "triangles.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Owns the points of the inputs it makes
+class Polygons {
+public:
+  // A star shaped polygon around the origin, with a square hole and Steiner
+  // points in some of them
+  p2t::BatchInput Make(unsigned seed)
+  {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> size(3, 60);
+    std::uniform_real_distribution<double> radius(5, 10);
+    p2t::BatchInput input;
+    const int n = size(rng);
+    for (int i = 0; i < n; ++i) {
+      const double angle = 2 * M_PI * i / n;
+      const double r = radius(rng);
+      input.polyline.push_back(NewPoint(r * std::cos(angle), r * std::sin(angle)));
+    }
+    if (seed % 3 == 0) {
+      input.holes.push_back(
+        { NewPoint(-1, -1), NewPoint(-1, 1), NewPoint(1, 1), NewPoint(1, -1) });
+    }
+    if (seed % 2 == 0) {
+      input.steiner.push_back(NewPoint(3, 0.5));
+      input.steiner.push_back(NewPoint(-2.5, 2));
+    }
+    return input;
+  }
+
+private:
+  p2t::Point* NewPoint(double x, double y)
+  {
+    points_.emplace_back(new p2t::Point(x, y));
+    return points_.back().get();
+  }
+
+  std::vector<std::unique_ptr<p2t::Point>> points_;
+};
+
+Triangles TriangulateOne(const p2t::BatchInput& input)
+{
+  p2t::CDT cdt(input.polyline);
+  for (auto& hole : input.holes) {
+    cdt.AddHole(hole);
+  }
+  for (auto p : input.steiner) {
+    cdt.AddPoint(p);
+  }
+  cdt.Triangulate();
+  return SortedTriangles(cdt.GetTriangles());
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(BatchTest)
+{
+  const unsigned num_inputs = 500;
+  Polygons single_polygons;
+  std::vector<Triangles> expected;
+  for (unsigned i = 0; i < num_inputs; ++i) {
+    expected.push_back(TriangulateOne(single_polygons.Make(i)));
+  }
+
+  for (unsigned num_threads : { 1, 3 }) {
+    p2t::BatchTriangulator batch(num_threads);
+    BOOST_CHECK_EQUAL(batch.thread_count(), num_threads);
+    std::vector<p2t::BatchResult> results;
+    // A second round runs on the scratch state and results of the first
+    for (int round = 0; round < 2; ++round) {
+      Polygons polygons;
+      std::vector<p2t::BatchInput> inputs;
+      for (unsigned i = 0; i < num_inputs; ++i) {
+        inputs.push_back(polygons.Make(i));
+      }
+      batch.Triangulate(inputs, results);
+      BOOST_REQUIRE_EQUAL(results.size(), inputs.size());
+      for (unsigned i = 0; i < num_inputs; ++i) {
+        BOOST_CHECK(!results[i].error);
+        BOOST_CHECK(SortedTriangles(results[i].triangles) == expected[i]);
+      }
+    }
+
+    batch.Triangulate({}, results);
+    BOOST_CHECK(results.empty());
+  }
+}
+
+#ifdef __SIZEOF_INT128__
+BOOST_AUTO_TEST_CASE(BatchErrorTest)
+{
+  // The integer kernel rejects the fractional point of the second input, the
+  // others still get triangulated
+  std::vector<p2t::Point> points{ { 0, 0 }, { 4, 0 }, { 0, 4 }, { 0.5, 0 }, { 4, 0 }, { 0, 4 },
+                                  { 0, 0 }, { 4, 0 }, { 4, 4 } };
+  std::vector<p2t::BatchInput> inputs(3);
+  for (size_t i = 0; i < points.size(); ++i) {
+    inputs[i / 3].polyline.push_back(&points[i]);
+  }
+  p2t::BasicBatchTriangulator<p2t::IntegerExactKernel> batch(2);
+  std::vector<p2t::BatchResult> results;
+  batch.Triangulate(inputs, results);
+  BOOST_CHECK(!results[0].error);
+  BOOST_CHECK_EQUAL(results[0].triangles.size(), 3u);
+  BOOST_CHECK(results[1].error);
+  BOOST_CHECK(results[1].triangles.empty());
+  BOOST_CHECK_THROW(std::rethrow_exception(results[1].error), p2t::poly2tri_exception);
+  BOOST_CHECK(!results[2].error);
+  BOOST_CHECK_EQUAL(results[2].triangles.size(), 3u);
+}
+#endif
@@ -0,0 +1,118 @@
+#if !defined(_WIN32) && !defined(BOOST_TEST_DYN_LINK)
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <poly2tri/poly2tri.h>
+#include <workloads.h>
+
+#include <algorithm>
+#include <string>
+
+namespace {
+
+void CheckOrdered(const p2t::MemoryUsage& usage, const std::string& name)
+{
+  BOOST_CHECK_MESSAGE(usage.live <= usage.peak, name);
+  BOOST_CHECK_MESSAGE(usage.peak <= usage.reserved, name);
+}
+
+void CheckOrdered(const p2t::MemoryReport& report)
+{
+  CheckOrdered(report.triangles, "triangles");
+  CheckOrdered(report.nodes, "nodes");
+  CheckOrdered(report.edges, "edges");
+  CheckOrdered(report.points, "points");
+  CheckOrdered(report.scratch, "scratch");
+}
+
+size_t Vertices(const workload::Polygon& polygon)
+{
+  size_t count = polygon.outline.size();
+  for (const auto& hole : polygon.holes) {
+    count += hole.size();
+  }
+  return count;
+}
+
+// Keeps the most triangles in use it saw while consuming
+class PeakSink : public p2t::TriangleSink {
+public:
+  explicit PeakSink(p2t::CDT& cdt) : cdt_(cdt) {}
+
+  void Consume(p2t::Triangle&) override
+  {
+    const p2t::MemoryReport report = cdt_.GetMemoryUsage();
+    CheckOrdered(report.triangles, "streamed triangles");
+    peak = std::max(peak, report.triangles.live);
+  }
+
+  size_t peak = 0;
+
+private:
+  p2t::CDT& cdt_;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(MemoryUsageTest)
+{
+  workload::Polygon polygon = workload::Uniform(20000, 1);
+  p2t::CDT cdt(workload::Pointers(polygon.outline));
+  workload::AddTo(cdt, polygon);
+  cdt.Triangulate();
+  const p2t::MemoryReport report = cdt.GetMemoryUsage();
+  CheckOrdered(report);
+  BOOST_CHECK_EQUAL(report.triangles.live, cdt.GetMap().size() * sizeof(p2t::Triangle) +
+                                             cdt.GetTriangles().size() * sizeof(p2t::Triangle*));
+  BOOST_CHECK_GE(report.edges.live, 4 * sizeof(p2t::Edge));
+  BOOST_CHECK_GE(report.points.live, polygon.size() * 2 * sizeof(p2t::Point*));
+  BOOST_CHECK_GT(report.nodes.peak, 0u);
+  BOOST_CHECK_GT(report.scratch.peak, 0u);
+  const p2t::MemoryUsage total = report.total();
+  BOOST_CHECK_EQUAL(total.peak, report.triangles.peak + report.nodes.peak + report.edges.peak +
+                                  report.points.peak + report.scratch.peak);
+
+  // A smaller polygon afterwards uses fewer triangles of the memory kept
+  // from before. Buffers count whole, at the size the larger one needed.
+  workload::Polygon small = workload::Uniform(2000, 2);
+  cdt.Reset(workload::Pointers(small.outline));
+  workload::AddTo(cdt, small);
+  cdt.Triangulate();
+  const p2t::MemoryReport again = cdt.GetMemoryUsage();
+  CheckOrdered(again);
+  BOOST_CHECK_LT(again.triangles.peak, report.triangles.peak / 5);
+  BOOST_CHECK_EQUAL(again.scratch.peak, again.scratch.reserved);
+  BOOST_CHECK_GE(again.total().reserved, total.reserved);
+
+  // Streaming lets go of the triangles behind the sweep
+  cdt.Reset(workload::Pointers(polygon.outline));
+  workload::AddTo(cdt, polygon);
+  PeakSink sink(cdt);
+  cdt.Triangulate(sink);
+  CheckOrdered(cdt.GetMemoryUsage());
+  BOOST_CHECK_GT(sink.peak, 0u);
+  BOOST_CHECK_LT(cdt.GetMemoryUsage().triangles.peak, report.triangles.peak / 4);
+}
+
+BOOST_AUTO_TEST_CASE(MemoryEstimateTest)
+{
+  // Never under the peak, and not far over but for small inputs, where the
+  // fixed costs weigh in
+  for (const workload::Workload& workload : workload::Workloads()) {
+    for (size_t num_points : { 100, 5000, 50000 }) {
+      workload::Polygon polygon = workload.make(num_points, 1);
+      p2t::CDT cdt(workload::Pointers(polygon.outline));
+      workload::AddTo(cdt, polygon);
+      cdt.Triangulate();
+      const double peak = static_cast<double>(cdt.GetMemoryUsage().total().peak);
+      const double estimate = static_cast<double>(
+        p2t::EstimatePeakMemory(Vertices(polygon), polygon.holes.size(), polygon.steiner.size()));
+      BOOST_CHECK_MESSAGE(estimate >= peak, workload.name << " " << num_points << ": " << estimate
+                                                          << " for " << peak);
+      if (num_points >= 5000) {
+        BOOST_CHECK_MESSAGE(estimate < 1.5 * peak, workload.name << " " << num_points << ": "
+                                                                 << estimate << " for " << peak);
+      }
+    }
+  }
+}
@@ -0,0 +1,79 @@
+#if !defined(_WIN32) && !defined(BOOST_TEST_DYN_LINK)
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <poly2tri/sweep/point_sort.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+void CheckSort(std::vector<p2t::Point>& points, unsigned num_threads)
+{
+  std::vector<p2t::Point*> expected;
+  for (auto& p : points) {
+    expected.push_back(&p);
+  }
+  const std::vector<p2t::Point*> input = expected;
+  std::vector<p2t::Point*> sorted = expected;
+  std::stable_sort(expected.begin(), expected.end(), p2t::cmp);
+  p2t::SortPoints(sorted, num_threads);
+  BOOST_CHECK(sorted == expected);
+
+  // Sorting a copy, which tells where each point went
+  std::vector<size_t> ranks;
+  p2t::PointSorter().Sort(input, sorted, ranks, num_threads);
+  BOOST_CHECK(sorted == expected);
+  BOOST_REQUIRE_EQUAL(ranks.size(), input.size());
+  bool ranked = true;
+  for (size_t i = 0; i < input.size(); ++i) {
+    ranked = ranked && sorted[ranks[i]] == input[i];
+  }
+  BOOST_CHECK(ranked);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(PointSortTest)
+{
+  std::mt19937_64 rng(13);
+  std::uniform_real_distribution<double> coord(-1e6, 1e6);
+  std::uniform_int_distribution<int> grid(-20, 20);
+
+  for (size_t n : { 0, 1, 100, 5000, 300000 }) {
+    std::vector<p2t::Point> points;
+    for (size_t i = 0; i < n; ++i) {
+      points.emplace_back(coord(rng), coord(rng));
+    }
+    CheckSort(points, 1);
+    CheckSort(points, 3);
+
+    // Pre-sorted and reversed
+    std::sort(points.begin(), points.end(),
+              [](const p2t::Point& a, const p2t::Point& b) { return p2t::cmp(&a, &b); });
+    CheckSort(points, 1);
+    std::reverse(points.begin(), points.end());
+    CheckSort(points, 4);
+  }
+
+  // Repeated coordinates, signed zeros and equal points, which keep their order
+  std::vector<p2t::Point> points;
+  for (int i = 0; i < 20000; ++i) {
+    const int x = grid(rng);
+    const int y = grid(rng);
+    points.emplace_back(x == 0 && i % 2 ? -0.0 : x * 0.25, y == 0 && i % 3 ? -0.0 : y);
+  }
+  CheckSort(points, 1);
+  CheckSort(points, 2);
+
+  // Coordinates differing only in the lowest bits, and spanning all magnitudes
+  points.clear();
+  for (int i = 0; i < 10000; ++i) {
+    points.emplace_back(1.0 + i % 7 * 1e-16, std::ldexp(i % 2 ? -1.0 : 1.0, i % 2000 - 1000));
+  }
+  CheckSort(points, 1);
+  CheckSort(points, 3);
+}
@@ -0,0 +1,149 @@
+#if !defined(_WIN32) && !defined(BOOST_TEST_DYN_LINK)
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <poly2tri/poly2tri.h>
+#include "triangles.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifdef POLY2TRI_USE_EXACT
+
+namespace {
+
+p2t::Orientation ExactOrient2d(const p2t::Point& a, const p2t::Point& b, const p2t::Point& c)
+{
+  return static_cast<p2t::Orientation>(
+    exact::orientation(std::array<double, 2>{ a.x, a.y }, std::array<double, 2>{ b.x, b.y },
+                       std::array<double, 2>{ c.x, c.y }));
+}
+
+bool ExactIncircle(const p2t::Point& a, const p2t::Point& b, const p2t::Point& c,
+                   const p2t::Point& d)
+{
+  return exact::in_circumcircle(std::array<double, 2>{ a.x, a.y }, std::array<double, 2>{ b.x, b.y },
+                                std::array<double, 2>{ c.x, c.y },
+                                std::array<double, 2>{ d.x, d.y }) != geometrix::oriented_right;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(Orient2dFilterTest)
+{
+  // Points within a few ulps of a line, where the floating point determinant
+  // is mostly noise and the filter has to defer to exact arithmetic
+  std::mt19937_64 rng(3);
+  std::uniform_real_distribution<double> t(0, 1);
+  std::uniform_int_distribution<int> ulps(-4, 4);
+  const p2t::Point a(0.1, 0.2), b(12.3, 4.56);
+  for (int i = 0; i < 10000; ++i) {
+    const double s = t(rng);
+    double x = a.x + s * (b.x - a.x);
+    double y = a.y + s * (b.y - a.y);
+    for (int k = ulps(rng); k > 0; --k) {
+      y = std::nextafter(y, 10.0);
+    }
+    for (int k = ulps(rng); k < 0; ++k) {
+      x = std::nextafter(x, -10.0);
+    }
+    const p2t::Point c(x, y);
+    BOOST_CHECK_EQUAL(p2t::Orient2d(a, b, c), ExactOrient2d(a, b, c));
+    BOOST_CHECK_EQUAL(p2t::Orient2d(c, a, b), ExactOrient2d(c, a, b));
+  }
+
+  // Exactly collinear
+  BOOST_CHECK_EQUAL(p2t::Orient2d(p2t::Point(0, 0), p2t::Point(1, 1), p2t::Point(3, 3)), p2t::COLLINEAR);
+  BOOST_CHECK_EQUAL(p2t::Orient2d(p2t::Point(0, 0), p2t::Point(1, 0), p2t::Point(0, 1)), p2t::CCW);
+  BOOST_CHECK_EQUAL(p2t::Orient2d(p2t::Point(0, 0), p2t::Point(0, 1), p2t::Point(1, 0)), p2t::CW);
+}
+
+BOOST_AUTO_TEST_CASE(IncircleFilterTest)
+{
+  // Points on and near the circle of radius 5 around the origin
+  const p2t::Point a(5, 0), b(0, 5), c(-5, 0);
+  BOOST_CHECK(p2t::Incircle(a, b, c, p2t::Point(3, -4)));
+  BOOST_CHECK(p2t::Incircle(a, b, c, p2t::Point(0, 0)));
+  BOOST_CHECK(!p2t::Incircle(a, b, c, p2t::Point(0, -5.5)));
+
+  std::mt19937_64 rng(5);
+  std::uniform_real_distribution<double> angle(M_PI, 2 * M_PI);
+  for (int i = 0; i < 10000; ++i) {
+    const double phi = angle(rng);
+    const p2t::Point d(5 * std::cos(phi), 5 * std::sin(phi));
+    BOOST_CHECK_EQUAL(p2t::Incircle(a, b, c, d), ExactIncircle(a, b, c, d));
+  }
+}
+
+#endif
+
+namespace {
+
+// Triangles of a triangulation as sorted vertex coordinates
+template <class Kernel>
+Triangles Triangulate(const std::vector<p2t::Point>& outline,
+                                             std::vector<p2t::Point> steiner)
+{
+  std::vector<p2t::Point> points = outline;
+  std::vector<p2t::Point*> polyline;
+  for (auto& p : points) {
+    polyline.push_back(&p);
+  }
+  p2t::BasicCDT<Kernel> cdt(polyline);
+  for (auto& p : steiner) {
+    cdt.AddPoint(&p);
+  }
+  cdt.Triangulate();
+  return SortedTriangles(cdt.GetTriangles());
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(KernelTest)
+{
+  const std::vector<p2t::Point> outline{ { -1000, -1000 }, { 1000, -1000 }, { 1000, 1000 },
+                                         { -1000, 1000 } };
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> coord(-999, 999);
+  std::vector<p2t::Point> steiner;
+  for (int i = 0; i < 2000; ++i) {
+    steiner.emplace_back(coord(rng), coord(rng));
+  }
+  std::sort(steiner.begin(), steiner.end(), [](const p2t::Point& a, const p2t::Point& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+  });
+  steiner.erase(std::unique(steiner.begin(), steiner.end()), steiner.end());
+
+  // Every kernel can be used side by side
+  const auto expected = static_cast<size_t>(2 * steiner.size() + 2);
+  BOOST_CHECK_EQUAL(Triangulate<p2t::InexactKernel>(outline, steiner).size(), expected);
+#ifdef POLY2TRI_USE_EXACT
+  const auto filtered = Triangulate<p2t::FilteredExactKernel>(outline, steiner);
+  BOOST_CHECK_EQUAL(filtered.size(), expected);
+#endif
+#ifdef __SIZEOF_INT128__
+  const auto integer = Triangulate<p2t::IntegerExactKernel>(outline, steiner);
+  BOOST_CHECK_EQUAL(integer.size(), expected);
+#ifdef POLY2TRI_USE_EXACT
+  BOOST_CHECK(integer == filtered);
+#endif
+
+  // A grid is full of cocircular points
+  std::vector<p2t::Point> grid;
+  for (int x = -900; x <= 900; x += 100) {
+    for (int y = -900; y <= 900; y += 100) {
+      grid.emplace_back(x, y);
+    }
+  }
+  BOOST_CHECK_EQUAL(Triangulate<p2t::IntegerExactKernel>(outline, grid).size(),
+                    static_cast<size_t>(2 * grid.size() + 2));
+
+  // Points that are not integers, or too large, are rejected
+  BOOST_CHECK_THROW(Triangulate<p2t::IntegerExactKernel>(outline, { { 0.5, 0 } }),
+                    p2t::poly2tri_exception);
+  BOOST_CHECK_THROW(Triangulate<p2t::IntegerExactKernel>(outline, { { 0, 1e9 } }),
+                    p2t::poly2tri_exception);
+#endif
+}
@@ -0,0 +1,163 @@
+#if !defined(_WIN32) && !defined(BOOST_TEST_DYN_LINK)
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <poly2tri/poly2tri.h>
+#include "triangles.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// One star shaped outline, square holes and a cloud of Steiner points, which
+// every triangulation picks from
+class SharedPoints {
+public:
+  SharedPoints()
+  {
+    std::mt19937 rng(11);
+    const int n = 120;
+    for (int i = 0; i < n; ++i) {
+      const double angle = 2 * M_PI * i / n;
+      const double r = i % 2 ? 30.0 : 20.0;
+      outline_.emplace_back(r * std::cos(angle), r * std::sin(angle));
+    }
+    const double centers[][2] = { { -8, -8 }, { 8, -8 }, { 8, 8 }, { -8, 8 }, { 0, 0 } };
+    for (auto& c : centers) {
+      holes_.push_back({ { c[0] - 1, c[1] - 1 }, { c[0] + 1, c[1] - 1 },
+                         { c[0] + 1, c[1] + 1 }, { c[0] - 1, c[1] + 1 } });
+    }
+    std::uniform_real_distribution<double> coord(-14, 14);
+    while (steiner_.size() < 300) {
+      const p2t::Point p(coord(rng), coord(rng));
+      const bool in_hole = std::any_of(std::begin(centers), std::end(centers), [&p](const double* c) {
+        return std::abs(p.x - c[0]) < 1.5 && std::abs(p.y - c[1]) < 1.5;
+      });
+      if (!in_hole) {
+        steiner_.push_back(p);
+      }
+    }
+  }
+
+  // The outline with the holes in the bits of mask and every third Steiner
+  // point, starting from the mask's
+  p2t::BatchInput Pick(unsigned mask)
+  {
+    p2t::BatchInput input;
+    for (auto& p : outline_) {
+      input.polyline.push_back(&p);
+    }
+    for (size_t h = 0; h < holes_.size(); ++h) {
+      if (mask & (1u << h)) {
+        input.holes.emplace_back();
+        for (auto& p : holes_[h]) {
+          input.holes.back().push_back(&p);
+        }
+      }
+    }
+    for (size_t i = mask % 3; i < steiner_.size(); i += 3) {
+      input.steiner.push_back(&steiner_[i]);
+    }
+    return input;
+  }
+
+  // Every coordinate, to see that nothing was written
+  std::vector<std::pair<double, double>> Coordinates() const
+  {
+    std::vector<std::pair<double, double>> coordinates;
+    for (auto points : { &outline_, &steiner_ }) {
+      for (auto& p : *points) {
+        coordinates.emplace_back(p.x, p.y);
+      }
+    }
+    for (auto& hole : holes_) {
+      for (auto& p : hole) {
+        coordinates.emplace_back(p.x, p.y);
+      }
+    }
+    return coordinates;
+  }
+
+  size_t hole_count() const { return holes_.size(); }
+
+private:
+  std::vector<p2t::Point> outline_;
+  std::vector<std::vector<p2t::Point>> holes_;
+  std::vector<p2t::Point> steiner_;
+};
+
+void Triangulate(p2t::CDT& cdt, const p2t::BatchInput& input, Triangles& triangles)
+{
+  cdt.Reset(input.polyline);
+  for (auto& hole : input.holes) {
+    cdt.AddHole(hole);
+  }
+  for (auto p : input.steiner) {
+    cdt.AddPoint(p);
+  }
+  cdt.Triangulate();
+  triangles = SortedTriangles(cdt.GetTriangles());
+}
+
+} // namespace
+
+// Many CDTs triangulate the same points at once. Meant to be run under
+// ThreadSanitizer as well, which reports any write to the shared points.
+BOOST_AUTO_TEST_CASE(SharedInputTest)
+{
+  SharedPoints shared;
+  const auto coordinates = shared.Coordinates();
+  const unsigned num_inputs = 1u << shared.hole_count();
+  std::vector<p2t::BatchInput> inputs;
+  for (unsigned mask = 0; mask < num_inputs; ++mask) {
+    inputs.push_back(shared.Pick(mask));
+  }
+
+  std::vector<Triangles> expected(num_inputs);
+  {
+    p2t::CDT cdt(std::vector<p2t::Point*>{});
+    for (unsigned i = 0; i < num_inputs; ++i) {
+      Triangulate(cdt, inputs[i], expected[i]);
+    }
+  }
+
+  // Every thread runs through all the inputs, starting at a different one so
+  // that the same input is in flight on several threads at a time
+  const unsigned num_threads = 4;
+  const unsigned rounds = 3;
+  std::vector<std::vector<Triangles>> results(num_threads, std::vector<Triangles>(num_inputs));
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      p2t::CDT cdt(std::vector<p2t::Point*>{});
+      for (unsigned k = 0; k < rounds * num_inputs; ++k) {
+        const unsigned i = (k + t) % num_inputs;
+        Triangulate(cdt, inputs[i], results[t][i]);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (unsigned t = 0; t < num_threads; ++t) {
+    for (unsigned i = 0; i < num_inputs; ++i) {
+      BOOST_CHECK(results[t][i] == expected[i]);
+    }
+  }
+
+  // The batch triangulator with every input sharing the outline
+  p2t::BatchTriangulator batch(num_threads);
+  std::vector<p2t::BatchResult> batch_results;
+  batch.Triangulate(inputs, batch_results);
+  for (unsigned i = 0; i < num_inputs; ++i) {
+    BOOST_CHECK(!batch_results[i].error);
+    BOOST_CHECK(SortedTriangles(batch_results[i].triangles) == expected[i]);
+  }
+
+  BOOST_CHECK(shared.Coordinates() == coordinates);
+}
@@ -0,0 +1,63 @@
+#if !defined(_WIN32) && !defined(BOOST_TEST_DYN_LINK)
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <poly2tri/poly2tri.h>
+#include <workloads.h>
+
+namespace {
+
+void Triangulate(p2t::CDT& cdt, workload::Polygon& polygon)
+{
+  cdt.Reset(workload::Pointers(polygon.outline));
+  workload::AddTo(cdt, polygon);
+  cdt.Triangulate();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(StatsTest)
+{
+  // A comb of 500 teeth, with points in its spine
+  workload::Polygon polygon = workload::Comb(2000, 1);
+  for (auto& p : workload::Uniform(2000, 1).steiner) {
+    polygon.steiner.emplace_back(999 * (p.x + 1) / 2, (p.y + 1) / 2);
+  }
+  p2t::CDT cdt(workload::Pointers(polygon.outline));
+  workload::AddTo(cdt, polygon);
+  cdt.Triangulate();
+  const p2t::TriangulationStats stats = cdt.GetStats();
+  BOOST_CHECK_EQUAL(stats.flips, cdt.GetFlipCount());
+  BOOST_CHECK_GT(stats.flips, 0u);
+
+#ifdef POLY2TRI_STATS
+  BOOST_CHECK_EQUAL(stats.locate_node, polygon.size() - 1);
+  BOOST_CHECK_GE(stats.locate_node_steps, stats.locate_node);
+  BOOST_CHECK_EQUAL(stats.edge_events, polygon.outline.size());
+  BOOST_CHECK_GE(stats.legalize, stats.flips);
+  BOOST_CHECK_GE(stats.incircle, stats.flips);
+  BOOST_CHECK_GT(stats.orient2d, 0u);
+  BOOST_CHECK_GT(stats.fills, 0u);
+  BOOST_CHECK_GT(stats.edge_flips, 0u);
+  // The teeth of the comb stand on the front at once
+  BOOST_CHECK_GT(stats.max_front, polygon.outline.size() / 4);
+  BOOST_CHECK_LE(stats.max_front, polygon.size() + 2);
+  BOOST_CHECK_GT(stats.sweep_ms, 0.0);
+  BOOST_CHECK_GE(stats.init_ms, 0.0);
+  BOOST_CHECK_GE(stats.finalize_ms, 0.0);
+#else
+  BOOST_CHECK_EQUAL(stats.legalize, 0u);
+  BOOST_CHECK_EQUAL(stats.locate_node, 0u);
+  BOOST_CHECK_EQUAL(stats.max_front, 0u);
+  BOOST_CHECK_EQUAL(stats.sweep_ms, 0.0);
+#endif
+
+  // Each triangulation counts afresh
+  Triangulate(cdt, polygon);
+  const p2t::TriangulationStats& again = cdt.GetStats();
+  BOOST_CHECK_EQUAL(again.flips, stats.flips);
+  BOOST_CHECK_EQUAL(again.legalize, stats.legalize);
+  BOOST_CHECK_EQUAL(again.locate_node_steps, stats.locate_node_steps);
+  BOOST_CHECK_EQUAL(again.incircle, stats.incircle);
+  BOOST_CHECK_EQUAL(again.max_front, stats.max_front);
+}
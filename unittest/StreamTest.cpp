@@ -0,0 +1,146 @@
+#if !defined(_WIN32) && !defined(BOOST_TEST_DYN_LINK)
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/filesystem/path.hpp>
+#include <boost/test/unit_test.hpp>
+#include <poly2tri/poly2tri.h>
+#include <input.h>
+#include <workloads.h>
+#include "triangles.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Keeps the vertices of what it is passed, three a triangle, and the most
+// triangles the CDT held meanwhile
+class CollectingSink : public p2t::TriangleSink {
+public:
+  explicit CollectingSink(p2t::CDT& cdt) : cdt_(cdt) {}
+
+  void Consume(p2t::Triangle& triangle) override
+  {
+    points.insert(points.end(),
+                  { triangle.GetPoint(0), triangle.GetPoint(1), triangle.GetPoint(2) });
+    peak = std::max(peak, cdt_.GetMap().size());
+  }
+
+  std::vector<p2t::Point*> points;
+  size_t peak = 0;
+
+private:
+  p2t::CDT& cdt_;
+};
+
+// Moves parsed points into a polygon's own
+void Take(std::vector<p2t::Point*>& parsed, std::vector<p2t::Point>& points)
+{
+  for (auto p : parsed) {
+    points.push_back(*p);
+    delete p;
+  }
+}
+
+// A testbed file, with its holes and Steiner points
+workload::Polygon Load(const std::string& filename)
+{
+#ifndef P2T_BASE_DIR
+  const auto basedir = boost::filesystem::path(__FILE__).remove_filename().parent_path();
+#else
+  const auto basedir = boost::filesystem::path(P2T_BASE_DIR);
+#endif
+  const auto datafile = basedir / boost::filesystem::path("testbed/data") / boost::filesystem::path(filename);
+  std::vector<p2t::Point*> outline, steiner;
+  std::vector<std::vector<p2t::Point*>> holes;
+  BOOST_REQUIRE(ParseFile(datafile.string(), outline, holes, steiner));
+  workload::Polygon polygon;
+  Take(outline, polygon.outline);
+  for (auto& hole : holes) {
+    polygon.holes.emplace_back();
+    Take(hole, polygon.holes.back());
+  }
+  Take(steiner, polygon.steiner);
+  return polygon;
+}
+
+// Streams the polygon, checking that it gives the triangles of a plain
+// triangulation. Returns the most triangles held while streaming, and the
+// number held in the end without.
+std::pair<size_t, size_t> Compare(workload::Polygon& polygon, const std::string& name)
+{
+  p2t::CDT cdt(workload::Pointers(polygon.outline));
+  workload::AddTo(cdt, polygon);
+  cdt.Triangulate();
+  const Triangles expected = SortedTriangles(cdt.GetTriangles());
+
+  p2t::CDT streaming(workload::Pointers(polygon.outline));
+  workload::AddTo(streaming, polygon);
+  CollectingSink sink(streaming);
+  streaming.Triangulate(sink);
+  BOOST_CHECK(streaming.GetTriangles().empty());
+  BOOST_CHECK_MESSAGE(SortedTriangles(sink.points) == expected, name);
+  return { sink.peak, cdt.GetMap().size() };
+}
+
+// The uniform workload, with a hole in the middle if asked, clear of
+// Steiner points
+workload::Polygon RandomSquare(unsigned seed, size_t num_points, bool hole)
+{
+  workload::Polygon polygon = workload::Uniform(num_points, seed);
+  if (hole) {
+    polygon.holes.push_back({ { -0.3, -0.2 }, { 0.3, -0.25 }, { 0.35, 0.3 }, { 0.0, 0.1 }, { -0.3, 0.3 } });
+    auto& steiner = polygon.steiner;
+    steiner.erase(std::remove_if(steiner.begin(), steiner.end(),
+                                 [](const p2t::Point& p) {
+                                   return p.x > -0.45 && p.x < 0.5 && p.y > -0.4 && p.y < 0.45;
+                                 }),
+                  steiner.end());
+  }
+  return polygon;
+}
+
+} // namespace
+
+// custom.dat is left out, its outline crosses itself
+BOOST_AUTO_TEST_CASE(StreamTestbedTest)
+{
+  for (const auto& filename : { "diamond.dat", "star.dat", "test.dat", "dude.dat", "stalactite.dat",
+                                "steiner.dat", "nazca_monkey.dat", "debug2.dat" }) {
+    workload::Polygon polygon = Load(filename);
+    Compare(polygon, filename);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(StreamRandomTest)
+{
+  for (unsigned seed = 1; seed <= 3; ++seed) {
+    for (bool hole : { false, true }) {
+      workload::Polygon polygon = RandomSquare(seed, 20000, hole);
+      const auto sizes = Compare(polygon, "random " + std::to_string(seed));
+      // The triangles behind the sweep are let go of
+      BOOST_CHECK_LT(sizes.first * 4, sizes.second);
+    }
+  }
+
+  // A small input is passed on in the end, all at once
+  workload::Polygon polygon = RandomSquare(4, 50, true);
+  Compare(polygon, "small");
+}
+
+BOOST_AUTO_TEST_CASE(StreamResetTest)
+{
+  workload::Polygon polygon = RandomSquare(5, 2000, true);
+  p2t::CDT cdt(workload::Pointers(polygon.outline));
+  workload::AddTo(cdt, polygon);
+  CollectingSink sink(cdt);
+  cdt.Triangulate(sink);
+
+  // The same CDT triangulates as usual afterwards
+  cdt.Reset(workload::Pointers(polygon.outline));
+  workload::AddTo(cdt, polygon);
+  cdt.Triangulate();
+  BOOST_CHECK(SortedTriangles(cdt.GetTriangles()) == SortedTriangles(sink.points));
+}
@@ -0,0 +1,187 @@
+#if !defined(_WIN32) && !defined(BOOST_TEST_DYN_LINK)
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <poly2tri/poly2tri.h>
+#include <workloads.h>
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Event {
+  bool begin;
+  p2t::TracePhase phase;
+  size_t arg;
+};
+
+// Keeps the events it gets, checking that every End matches the latest
+// open Begin
+class RecordingTracer : public p2t::Tracer {
+public:
+  void Begin(p2t::TracePhase phase, size_t arg) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events.push_back({ true, phase, arg });
+    if (nested) {
+      open_.push_back({ true, phase, arg });
+    }
+  }
+
+  void End(p2t::TracePhase phase, size_t arg) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events.push_back({ false, phase, arg });
+    if (nested) {
+      if (open_.empty() || open_.back().phase != phase || open_.back().arg != arg) {
+        ++unmatched;
+      } else {
+        open_.pop_back();
+      }
+    }
+  }
+
+  size_t Count(p2t::TracePhase phase) const
+  {
+    return static_cast<size_t>(std::count_if(events.begin(), events.end(), [phase](const Event& e) {
+      return e.begin && e.phase == phase;
+    }));
+  }
+
+  bool balanced() const { return open_.empty() && unmatched == 0; }
+
+  // Whether the spans come from one thread, and nest
+  bool nested = true;
+  std::vector<Event> events;
+  size_t unmatched = 0;
+
+private:
+  std::mutex mutex_;
+  std::vector<Event> open_;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TraceSweepTest)
+{
+  workload::Polygon polygon = workload::Uniform(10000, 1);
+  p2t::CDT cdt(workload::Pointers(polygon.outline));
+  workload::AddTo(cdt, polygon);
+  RecordingTracer tracer;
+  tracer.chunk_points = 1000;
+  cdt.SetTracer(&tracer);
+  cdt.Triangulate();
+  const size_t num_triangles = cdt.GetTriangles().size();
+  BOOST_CHECK(tracer.balanced());
+
+  // Everything happens within Triangulate, the phases one after another
+  const size_t n = polygon.size();
+  BOOST_REQUIRE_GE(tracer.events.size(), 2u);
+  BOOST_CHECK(tracer.events.front().begin);
+  BOOST_CHECK(tracer.events.front().phase == p2t::TracePhase::kTriangulate);
+  BOOST_CHECK_EQUAL(tracer.events.front().arg, n);
+  BOOST_CHECK(tracer.events.back().phase == p2t::TracePhase::kTriangulate);
+  std::vector<p2t::TracePhase> phases;
+  for (const Event& e : tracer.events) {
+    const bool top = e.phase == p2t::TracePhase::kInit || e.phase == p2t::TracePhase::kSweep ||
+                     e.phase == p2t::TracePhase::kFinalize;
+    if (e.begin && top) {
+      phases.push_back(e.phase);
+    }
+  }
+  const std::vector<p2t::TracePhase> expected = { p2t::TracePhase::kInit, p2t::TracePhase::kSweep,
+                                                  p2t::TracePhase::kFinalize };
+  BOOST_CHECK(phases == expected);
+
+  // Points 1 to n - 1 are swept, in chunks starting every 1000
+  BOOST_CHECK_EQUAL(tracer.Count(p2t::TracePhase::kSweepChunk), (n - 1 + 999) / 1000);
+  size_t first = 1;
+  for (const Event& e : tracer.events) {
+    if (e.begin && e.phase == p2t::TracePhase::kSweepChunk) {
+      BOOST_CHECK_EQUAL(e.arg, first);
+      first += 1000;
+    }
+  }
+  // Of the square's edges only the two upright ones are long
+  BOOST_CHECK_EQUAL(tracer.Count(p2t::TracePhase::kEdgeEvent), 2u);
+
+  // Then every edge, and as one chunk
+  tracer.events.clear();
+  tracer.long_edge = 0;
+  tracer.chunk_points = n;
+  cdt.Reset(workload::Pointers(polygon.outline));
+  workload::AddTo(cdt, polygon);
+  cdt.Triangulate();
+  BOOST_CHECK(tracer.balanced());
+  BOOST_CHECK_EQUAL(tracer.Count(p2t::TracePhase::kSweepChunk), 1u);
+  BOOST_CHECK_EQUAL(tracer.Count(p2t::TracePhase::kEdgeEvent), 4u);
+  BOOST_CHECK_EQUAL(cdt.GetTriangles().size(), num_triangles);
+
+  // And no more once the tracer is taken away
+  tracer.events.clear();
+  cdt.SetTracer(nullptr);
+  cdt.Reset(workload::Pointers(polygon.outline));
+  workload::AddTo(cdt, polygon);
+  cdt.Triangulate();
+  BOOST_CHECK(tracer.events.empty());
+  BOOST_CHECK_EQUAL(cdt.GetTriangles().size(), num_triangles);
+}
+
+#ifdef __SIZEOF_INT128__
+BOOST_AUTO_TEST_CASE(TraceThrowTest)
+{
+  // The integer kernel turns down the point off the grid, and the spans
+  // open then are closed all the same
+  std::vector<p2t::Point> points = { { 0, 0 }, { 4, 0 }, { 4, 4 }, { 0.5, 4 } };
+  p2t::BasicCDT<p2t::IntegerExactKernel> cdt(workload::Pointers(points));
+  RecordingTracer tracer;
+  cdt.SetTracer(&tracer);
+  BOOST_CHECK_THROW(cdt.Triangulate(), std::exception);
+  BOOST_CHECK(tracer.balanced());
+  BOOST_CHECK_EQUAL(tracer.events.size(), 4u);
+  BOOST_CHECK_EQUAL(tracer.Count(p2t::TracePhase::kInit), 1u);
+  BOOST_CHECK_EQUAL(tracer.Count(p2t::TracePhase::kSweep), 0u);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(TraceBatchTest)
+{
+  std::vector<workload::Polygon> polygons;
+  std::vector<p2t::BatchInput> inputs;
+  for (unsigned seed = 1; seed <= 16; ++seed) {
+    polygons.push_back(workload::TinyHoles(200 + 10 * seed, seed));
+  }
+  for (auto& polygon : polygons) {
+    p2t::BatchInput input;
+    input.polyline = workload::Pointers(polygon.outline);
+    for (auto& hole : polygon.holes) {
+      input.holes.push_back(workload::Pointers(hole));
+    }
+    inputs.push_back(input);
+  }
+
+  RecordingTracer tracer;
+  tracer.nested = false;
+  p2t::BatchTriangulator batch(3);
+  batch.SetTracer(&tracer);
+  std::vector<p2t::BatchResult> results;
+  batch.Triangulate(inputs, results);
+
+  // One span for each input, around its triangulation
+  std::vector<size_t> indices;
+  for (const Event& e : tracer.events) {
+    if (e.begin && e.phase == p2t::TracePhase::kBatchInput) {
+      indices.push_back(e.arg);
+    }
+  }
+  std::sort(indices.begin(), indices.end());
+  BOOST_REQUIRE_EQUAL(indices.size(), inputs.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    BOOST_CHECK_EQUAL(indices[i], i);
+  }
+  BOOST_CHECK_EQUAL(tracer.Count(p2t::TracePhase::kTriangulate), inputs.size());
+  BOOST_CHECK_EQUAL(tracer.events.size() % 2, 0u);
+}
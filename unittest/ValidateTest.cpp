@@ -0,0 +1,169 @@
+#if !defined(_WIN32) && !defined(BOOST_TEST_DYN_LINK)
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <poly2tri/poly2tri.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+bool SameReport(const p2t::MeshReport& a, const p2t::MeshReport& b)
+{
+  return a.not_ccw == b.not_ccw && a.bad_neighbors == b.bad_neighbors &&
+         a.bad_constraints == b.bad_constraints && a.not_delaunay == b.not_delaunay &&
+         a.missing_edges == b.missing_edges;
+}
+
+// The corner of the rectangle's two triangles that is off their diagonal
+// and in the triangle first in GetTriangles
+p2t::Point* OffDiagonal(p2t::CDT& cdt)
+{
+  p2t::Triangle& t = *cdt.GetTriangles()[0];
+  for (int i = 0; i < 3; ++i) {
+    if (!t.constrained_edge[i]) {
+      return t.GetPoint(i);
+    }
+  }
+  return nullptr;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ValidateRectangleTest)
+{
+  std::vector<std::unique_ptr<p2t::Point>> points;
+  for (auto xy : { std::make_pair(0.0, 0.0), std::make_pair(2.0, 0.0), std::make_pair(2.0, 1.0),
+                   std::make_pair(0.0, 1.0) }) {
+    points.emplace_back(new p2t::Point(xy.first, xy.second));
+  }
+  std::vector<p2t::Point*> polyline;
+  for (auto& p : points) {
+    polyline.push_back(p.get());
+  }
+  p2t::CDT cdt(polyline);
+  cdt.Triangulate();
+  BOOST_REQUIRE_EQUAL(cdt.GetTriangles().size(), 2u);
+  BOOST_CHECK(cdt.Validate().ok());
+  BOOST_CHECK(p2t::IsDelaunay(cdt.GetTriangles()));
+
+  // Pulled in towards the middle, the corner off the diagonal falls in the
+  // circle of the other triangle
+  p2t::Point& corner = *OffDiagonal(cdt);
+  const p2t::Point saved = corner;
+  corner.set(saved.x + 0.3 * (1.0 - saved.x), saved.y + 0.3 * (0.5 - saved.y));
+  p2t::MeshReport report = cdt.Validate();
+  BOOST_CHECK_EQUAL(report.not_delaunay, 1u);
+  BOOST_CHECK_EQUAL(report.not_ccw + report.bad_neighbors + report.bad_constraints, 0u);
+  BOOST_CHECK(!p2t::IsDelaunay(cdt.GetTriangles()));
+
+  // Past the diagonal its triangle turns clockwise
+  corner.set(2.0 - saved.x, 1.0 - saved.y);
+  BOOST_CHECK_EQUAL(cdt.Validate().not_ccw, 1u);
+  corner = saved;
+  BOOST_CHECK(cdt.Validate().ok());
+
+  // A boundary edge that lost its constraint is reported twice over
+  p2t::Triangle& t = *cdt.GetTriangles()[0];
+  const int boundary = t.constrained_edge[0] ? 0 : 1;
+  t.constrained_edge[boundary] = false;
+  report = cdt.Validate();
+  BOOST_CHECK_EQUAL(report.bad_constraints, 1u);
+  BOOST_CHECK_EQUAL(report.missing_edges, 1u);
+  t.constrained_edge[boundary] = true;
+
+  // So is a one-sided neighbor link
+  p2t::Triangle* other = cdt.GetTriangles()[1];
+  t.ClearNeighbor(other);
+  report = cdt.Validate();
+  BOOST_CHECK_EQUAL(report.bad_neighbors, 1u);
+  BOOST_CHECK_EQUAL(report.bad_constraints, 1u);
+  t.MarkNeighbor(*other);
+  BOOST_CHECK(cdt.Validate().ok());
+}
+
+BOOST_AUTO_TEST_CASE(ValidateParallelTest)
+{
+  // A square with a grid of square holes, and points between them
+  std::vector<std::unique_ptr<p2t::Point>> points;
+  const auto point = [&points](double x, double y) {
+    points.emplace_back(new p2t::Point(x, y));
+    return points.back().get();
+  };
+  p2t::CDT cdt({ point(0, 0), point(20, 0), point(20, 20), point(0, 20) });
+  for (int i = 1; i < 19; i += 2) {
+    for (int j = 1; j < 19; j += 2) {
+      cdt.AddHole({ point(i, j), point(i, j + 1), point(i + 1, j + 1), point(i + 1, j) });
+    }
+  }
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> coord(0.01, 19.99);
+  for (int k = 0; k < 50000; ++k) {
+    const double x = coord(rng), y = coord(rng);
+    const bool in_hole = static_cast<int>(x) % 2 == 1 && static_cast<int>(y) % 2 == 1;
+    if (!in_hole && x < 19 && y < 19) {
+      cdt.AddPoint(point(x, y));
+    }
+  }
+  cdt.Triangulate();
+
+  const p2t::MeshReport report = cdt.Validate();
+  BOOST_CHECK_EQUAL(report.not_ccw, 0u);
+  BOOST_CHECK_EQUAL(report.bad_neighbors, 0u);
+  BOOST_CHECK_EQUAL(report.bad_constraints, 0u);
+  BOOST_CHECK_EQUAL(report.missing_edges, 0u);
+  for (unsigned num_threads : { 0u, 2u, 4u, 7u }) {
+    BOOST_CHECK(SameReport(cdt.Validate(num_threads), report));
+  }
+
+  // The same answer for triangles in another order, looked up by address
+  std::vector<p2t::Triangle*> shuffled = cdt.GetTriangles();
+  std::shuffle(shuffled.begin(), shuffled.end(), rng);
+  BOOST_CHECK_EQUAL(p2t::IsDelaunay(shuffled), p2t::IsDelaunay(cdt.GetTriangles()));
+}
+
+namespace {
+
+class NullSink : public p2t::TriangleSink {
+public:
+  void Consume(p2t::Triangle&) override {}
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ValidateStreamTest)
+{
+  // A star shaped 64-gon, whose edges are all constrained
+  std::vector<std::unique_ptr<p2t::Point>> points;
+  std::vector<p2t::Point*> polyline;
+  for (int i = 0; i < 64; ++i) {
+    const double angle = 2 * M_PI * i / 64;
+    const double r = 1.0 + 0.1 * (i % 3);
+    points.emplace_back(new p2t::Point(r * std::cos(angle), r * std::sin(angle)));
+    polyline.push_back(points.back().get());
+  }
+  p2t::CDT cdt(polyline);
+  NullSink sink;
+  cdt.Triangulate(sink);
+  BOOST_CHECK_THROW(cdt.Validate(4), p2t::poly2tri_exception);
+
+  // Triangulated as usual it is checked on any number of threads, the
+  // point index being built before they start
+  cdt.Reset(polyline);
+  cdt.Triangulate();
+  const p2t::MeshReport report = cdt.Validate(1);
+  BOOST_CHECK_EQUAL(report.missing_edges + report.bad_constraints + report.bad_neighbors, 0u);
+  for (unsigned num_threads : { 2u, 4u, 8u }) {
+    cdt.Reset(polyline);
+    cdt.Triangulate();
+    BOOST_CHECK(SameReport(cdt.Validate(num_threads), report));
+  }
+
+  // Without triangles, every edge is missing
+  cdt.Reset(polyline);
+  BOOST_CHECK_EQUAL(cdt.Validate(4).missing_edges, 64u);
+}
@@ -0,0 +1,79 @@
+#if !defined(_WIN32) && !defined(BOOST_TEST_DYN_LINK)
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <poly2tri/poly2tri.h>
+#include <workloads.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+bool SamePoints(const std::vector<p2t::Point>& a, const std::vector<p2t::Point>& b)
+{
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (a[i].x != b[i].x || a[i].y != b[i].y) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SamePolygon(const workload::Polygon& a, const workload::Polygon& b)
+{
+  if (!SamePoints(a.outline, b.outline) || !SamePoints(a.steiner, b.steiner) ||
+      a.holes.size() != b.holes.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.holes.size(); ++i) {
+    if (!SamePoints(a.holes[i], b.holes[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(WorkloadTriangulationTest)
+{
+  for (const workload::Workload& w : workload::Workloads()) {
+    for (std::uint64_t seed : { 1, 2 }) {
+      const size_t num_points = 3000;
+      workload::Polygon polygon = w.make(num_points, seed);
+      BOOST_CHECK_MESSAGE(polygon.size() >= num_points / 2 && polygon.size() <= 2 * num_points, w.name);
+
+      p2t::CDT cdt(workload::Pointers(polygon.outline));
+      workload::AddTo(cdt, polygon);
+      cdt.Triangulate();
+      const p2t::MeshReport report = cdt.Validate();
+      BOOST_CHECK_MESSAGE(report.not_ccw == 0 && report.bad_neighbors == 0 &&
+                              report.bad_constraints == 0 && report.missing_edges == 0,
+                          w.name);
+
+      // Euler's formula: a polygon of n points, b of them on its outline and
+      // its h holes, makes 2n - b - 2 + 2h triangles
+      size_t boundary = polygon.outline.size();
+      for (const auto& hole : polygon.holes) {
+        boundary += hole.size();
+      }
+      BOOST_CHECK_MESSAGE(cdt.GetTriangles().size() ==
+                              2 * polygon.size() - boundary - 2 + 2 * polygon.holes.size(),
+                          w.name);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(WorkloadSeedTest)
+{
+  for (const workload::Workload& w : workload::Workloads()) {
+    BOOST_CHECK_MESSAGE(SamePolygon(w.make(500, 7), w.make(500, 7)), w.name);
+    BOOST_CHECK_MESSAGE(!SamePolygon(w.make(500, 7), w.make(500, 8)), w.name);
+  }
+  BOOST_CHECK(workload::FindWorkload("comb") != nullptr);
+  BOOST_CHECK(workload::FindWorkload("no such workload") == nullptr);
+}
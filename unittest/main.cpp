@@ -8,6 +8,8 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <iterator>
@@ -261,3 +263,361 @@ BOOST_AUTO_TEST_CASE(TestbedFilesTest)
     }
   }
 }
+
+BOOST_AUTO_TEST_CASE(TriangleMapTest)
+{
+  std::vector<p2t::Point*> polyline{ new p2t::Point(0, 0), new p2t::Point(0, 1),
+                                     new p2t::Point(1, 1), new p2t::Point(1, 0) };
+  p2t::CDT cdt{ polyline };
+  BOOST_CHECK_NO_THROW(cdt.Triangulate());
+  const p2t::TriangleMap& map = cdt.GetMap();
+  BOOST_CHECK_EQUAL(&map, &cdt.GetMap());
+  const auto size = map.size();
+  BOOST_CHECK_EQUAL(static_cast<size_t>(std::distance(map.begin(), map.end())), size);
+  for (const auto t : cdt.GetTriangles()) {
+    BOOST_CHECK(std::find(map.begin(), map.end(), t) != map.end());
+  }
+
+  // Removed triangles are skipped and their slots are reused
+  p2t::TriangleMap own;
+  p2t::Triangle* first = own.Create(*polyline[0], *polyline[1], *polyline[2]);
+  own.Create(*polyline[0], *polyline[2], *polyline[3]);
+  own.Remove(first);
+  BOOST_CHECK_EQUAL(own.size(), 1u);
+  BOOST_CHECK(std::find(own.begin(), own.end(), first) == own.end());
+  BOOST_CHECK_EQUAL(own.Create(*polyline[0], *polyline[1], *polyline[2]), first);
+  BOOST_CHECK_EQUAL(own.size(), 2u);
+  for (const auto p : polyline) {
+    delete p;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LegalizeCascadeTest)
+{
+  // Points on a convex curve make every new point flip a long chain of edges
+  std::vector<p2t::Point> points;
+  const int n = 2000;
+  for (int i = 1; i <= n; ++i) {
+    const double x = -0.99 + 1.98 * i / (n + 1);
+    points.emplace_back(x, x * x);
+  }
+  std::vector<p2t::Point*> polyline{ new p2t::Point(-1, -1), new p2t::Point(1, -1),
+                                     new p2t::Point(1, 2), new p2t::Point(-1, 2) };
+  size_t flips = 0;
+  for (int run = 0; run < 2; ++run) {
+    p2t::CDT cdt{ polyline };
+    for (auto& p : points) {
+      cdt.AddPoint(&p);
+    }
+    BOOST_CHECK_NO_THROW(cdt.Triangulate());
+    const auto result = cdt.GetTriangles();
+    BOOST_CHECK_EQUAL(result.size(), static_cast<size_t>(2 * n + 2));
+    BOOST_CHECK_GT(cdt.GetFlipCount(), static_cast<size_t>(n));
+    if (run == 1) {
+      BOOST_CHECK_EQUAL(cdt.GetFlipCount(), flips);
+    }
+    flips = cdt.GetFlipCount();
+  }
+  for (const auto p : polyline) {
+    delete p;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LongConstraintTest)
+{
+  // The edges of a sliver hole run through a band of Steiner points, so each
+  // of them crosses thousands of triangles when it is inserted
+  const auto line = [](double x) { return 0.5 + 1e-3 * (x - 0.5); };
+  std::vector<p2t::Point*> polyline{ new p2t::Point(0, 0), new p2t::Point(1, 0),
+                                     new p2t::Point(1, 1), new p2t::Point(0, 1) };
+  std::vector<p2t::Point*> hole{ new p2t::Point(0.001, line(0.001)),
+                                 new p2t::Point(0.999, line(0.999)),
+                                 new p2t::Point(0.999, line(0.999) + 1e-7) };
+  std::vector<p2t::Point> points;
+  const int n = 20000;
+  for (int i = 0; i < n; ++i) {
+    const double x = 0.002 + 0.988 * i / n;
+    const double offset = 1e-6 + 9e-6 * ((i * 7919) % 1000) / 1000.0;
+    points.emplace_back(x, i % 2 == 0 ? line(x) + 1e-7 + offset : line(x) - offset);
+  }
+  p2t::CDT cdt{ polyline };
+  cdt.AddHole(hole);
+  for (auto& p : points) {
+    cdt.AddPoint(&p);
+  }
+  BOOST_CHECK_NO_THROW(cdt.Triangulate());
+  BOOST_CHECK_EQUAL(cdt.GetTriangles().size(), static_cast<size_t>(2 * n + 7));
+  for (const auto p : polyline) {
+    delete p;
+  }
+  for (const auto p : hole) {
+    delete p;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CDTResetTest)
+{
+  // A reset CDT triangulates like a new one, whatever it triangulated before
+  const auto make_polygon = [](int n, double scale) {
+    std::vector<p2t::Point*> polyline;
+    for (int i = 0; i < n; ++i) {
+      const double angle = 2 * M_PI * i / n;
+      const double r = scale * (i % 2 ? 1.0 : 0.6);
+      polyline.push_back(new p2t::Point(r * std::cos(angle), r * std::sin(angle)));
+    }
+    return polyline;
+  };
+  const auto triangles = [](p2t::CDT& cdt) {
+    std::vector<std::vector<double>> result;
+    for (auto t : cdt.GetTriangles()) {
+      result.push_back({ t->GetPoint(0)->x, t->GetPoint(0)->y, t->GetPoint(1)->x,
+                         t->GetPoint(1)->y, t->GetPoint(2)->x, t->GetPoint(2)->y });
+    }
+    return result;
+  };
+
+  std::vector<p2t::Point*> first = make_polygon(10, 1);
+  p2t::CDT cdt{ first };
+  cdt.Triangulate();
+
+  // A failed triangulation leaves nothing behind either. Only the exact
+  // predicates find the points collinear and fail.
+  std::vector<p2t::Point*> collinear{ new p2t::Point(0, 0), new p2t::Point(1, 0),
+                                      new p2t::Point(2, 0) };
+  cdt.Reset(collinear);
+#ifdef POLY2TRI_USE_EXACT
+  BOOST_CHECK_THROW(cdt.Triangulate(), std::exception);
+#endif
+
+  // The same points are triangulated again, by this CDT and a new one
+  std::vector<p2t::Point*> small = make_polygon(12, 12);
+  std::vector<p2t::Point*> medium = make_polygon(60, 60);
+  std::vector<p2t::Point*> large = make_polygon(200, 200);
+  std::vector<p2t::Point*> hole{ new p2t::Point(-1, -1), new p2t::Point(1, -1),
+                                 new p2t::Point(1, 1), new p2t::Point(-1, 1) };
+  for (auto polyline : { &large, &small, &medium, &large }) {
+    cdt.Reset(*polyline);
+    cdt.AddHole(hole);
+    BOOST_REQUIRE_NO_THROW(cdt.Triangulate());
+
+    p2t::CDT fresh{ *polyline };
+    fresh.AddHole(hole);
+    fresh.Triangulate();
+    BOOST_CHECK_EQUAL(cdt.GetTriangles().size(), polyline->size() + 4);
+    BOOST_CHECK(triangles(cdt) == triangles(fresh));
+  }
+  for (auto points : { &first, &collinear, &small, &medium, &large, &hole }) {
+    for (const auto p : *points) {
+      delete p;
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CoordinateBufferTest)
+{
+  // A square with a triangular hole and a Steiner point
+  const double coords[] = { 0, 0, 10, 0, 10, 10, 0, 10, 2, 2, 4, 2, 3, 4, 7, 7 };
+  const size_t holes[] = { 4 };
+  const p2t::CoordinateBuffer<double> input{ coords, 8, holes, 1, 7 };
+
+  std::vector<p2t::Point*> polyline, hole;
+  for (size_t i = 0; i < 4; ++i) {
+    polyline.push_back(new p2t::Point(coords[2 * i], coords[2 * i + 1]));
+    hole.push_back(new p2t::Point(coords[2 * i + 8], coords[2 * i + 9]));
+  }
+  hole.pop_back();
+  p2t::Point steiner(coords[14], coords[15]);
+  p2t::CDT expected{ polyline };
+  expected.AddHole(hole);
+  expected.AddPoint(&steiner);
+  expected.Triangulate();
+
+  const auto check = [&expected, &coords](p2t::CDT& cdt) {
+    std::vector<size_t> indices;
+    cdt.GetTriangleIndices(indices);
+    BOOST_REQUIRE_EQUAL(indices.size(), 3 * expected.GetTriangles().size());
+    for (size_t t = 0; t < expected.GetTriangles().size(); ++t) {
+      for (int i = 0; i < 3; ++i) {
+        const p2t::Point* p = expected.GetTriangles()[t]->GetPoint(i);
+        BOOST_CHECK_EQUAL(coords[2 * indices[3 * t + i]], p->x);
+        BOOST_CHECK_EQUAL(coords[2 * indices[3 * t + i] + 1], p->y);
+      }
+    }
+  };
+
+  p2t::CDT cdt(input);
+  cdt.Triangulate();
+  check(cdt);
+  BOOST_CHECK_THROW(cdt.GetPointIndex(&steiner), p2t::poly2tri_exception);
+
+  // Single precision, into the same CDT
+  std::vector<float> float_coords(std::begin(coords), std::end(coords));
+  cdt.Reset(p2t::CoordinateBuffer<float>{ float_coords.data(), 8, holes, 1, 7 });
+  cdt.Triangulate();
+  check(cdt);
+
+  // Rings of less than three points are rejected
+  const size_t bad_holes[] = { 4, 6 };
+  BOOST_CHECK_THROW(cdt.Reset(p2t::CoordinateBuffer<double>{ coords, 8, bad_holes, 2, 7 }),
+                    p2t::poly2tri_exception);
+  BOOST_CHECK_THROW(cdt.Reset(p2t::CoordinateBuffer<double>{ coords, 8, holes, 1, 9 }),
+                    p2t::poly2tri_exception);
+
+  for (auto points : { &polyline, &hole }) {
+    for (const auto p : *points) {
+      delete p;
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ExportTrianglesTest)
+{
+  // A star with a square hole and Steiner points, numbered in input order
+  std::vector<p2t::Point*> polyline;
+  const int n = 40;
+  for (int i = 0; i < n; ++i) {
+    const double angle = 2 * M_PI * i / n;
+    const double r = i % 2 ? 10.0 : 6.0;
+    polyline.push_back(new p2t::Point(r * std::cos(angle), r * std::sin(angle)));
+  }
+  std::vector<p2t::Point*> hole{ new p2t::Point(-1, -1), new p2t::Point(1, -1),
+                                 new p2t::Point(1, 1), new p2t::Point(-1, 1) };
+  std::vector<p2t::Point> steiner{ { 3, 0.5 }, { -2.5, 2 }, { 0.5, -3 } };
+  std::vector<const p2t::Point*> input(polyline.begin(), polyline.end());
+  input.insert(input.end(), hole.begin(), hole.end());
+
+  p2t::CDT cdt{ polyline };
+  cdt.AddHole(hole);
+  for (auto& p : steiner) {
+    cdt.AddPoint(&p);
+    input.push_back(&p);
+  }
+  cdt.Triangulate();
+  const auto& result = cdt.GetTriangles();
+  const size_t num_triangles = result.size();
+
+  std::vector<std::uint32_t> triangles(3 * num_triangles), neighbors(3 * num_triangles);
+  std::vector<std::uint8_t> constrained(num_triangles);
+  cdt.ExportTriangles(triangles.data(), neighbors.data(), constrained.data());
+
+  const std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+  size_t boundary_edges = 0;
+  for (size_t k = 0; k < num_triangles; ++k) {
+    for (int i = 0; i < 3; ++i) {
+      BOOST_CHECK_EQUAL(input[triangles[3 * k + i]], result[k]->GetPoint(i));
+      // Only the polygon's own edges are constrained, and nothing lies across them
+      const bool is_constrained = (constrained[k] >> i) & 1;
+      BOOST_CHECK_EQUAL(is_constrained, neighbors[3 * k + i] == none);
+      if (neighbors[3 * k + i] == none) {
+        ++boundary_edges;
+        continue;
+      }
+      // The neighbor has the same edge and points back
+      const size_t m = neighbors[3 * k + i];
+      const std::uint32_t a = triangles[3 * k + (i + 1) % 3], b = triangles[3 * k + (i + 2) % 3];
+      bool found = false;
+      for (int j = 0; j < 3; ++j) {
+        const std::uint32_t c = triangles[3 * m + (j + 1) % 3], d = triangles[3 * m + (j + 2) % 3];
+        if (neighbors[3 * m + j] == k && ((a == c && b == d) || (a == d && b == c))) {
+          found = true;
+        }
+      }
+      BOOST_CHECK(found);
+    }
+  }
+  BOOST_CHECK_EQUAL(boundary_edges, polyline.size() + hole.size());
+
+  // Other index types, and one too small for the points
+  std::vector<std::uint16_t> small(3 * num_triangles);
+  cdt.ExportTriangles(small.data());
+  BOOST_CHECK(std::equal(small.begin(), small.end(), triangles.begin()));
+  std::vector<size_t> indices;
+  cdt.GetTriangleIndices(indices);
+  BOOST_CHECK(std::equal(indices.begin(), indices.end(), triangles.begin()));
+  std::vector<std::uint8_t> tiny(3 * num_triangles);
+  BOOST_CHECK_NO_THROW(cdt.ExportTriangles(tiny.data()));
+  std::vector<p2t::Point*> large;
+  for (int i = 0; i < 300; ++i) {
+    const double angle = 2 * M_PI * i / 300;
+    large.push_back(new p2t::Point(std::cos(angle), std::sin(angle)));
+  }
+  p2t::CDT large_cdt{ large };
+  large_cdt.Triangulate();
+  tiny.resize(3 * large_cdt.GetTriangles().size());
+  BOOST_CHECK_THROW(large_cdt.ExportTriangles(tiny.data()), p2t::poly2tri_exception);
+
+  for (auto points : { &polyline, &hole, &large }) {
+    for (const auto p : *points) {
+      delete p;
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CompactMeshTest)
+{
+  // A star with a square hole and a Steiner point
+  std::vector<p2t::Point*> polyline;
+  const int n = 24;
+  for (int i = 0; i < n; ++i) {
+    const double angle = 2 * M_PI * i / n;
+    const double r = i % 2 ? 10.0 : 6.0;
+    polyline.push_back(new p2t::Point(r * std::cos(angle), r * std::sin(angle)));
+  }
+  std::vector<p2t::Point*> hole{ new p2t::Point(-1, -1), new p2t::Point(1, -1),
+                                 new p2t::Point(1, 1), new p2t::Point(-1, 1) };
+  p2t::Point steiner(3, 0.5);
+  p2t::CDT cdt{ polyline };
+  cdt.AddHole(hole);
+  cdt.AddPoint(&steiner);
+  cdt.Triangulate();
+  const size_t num_triangles = cdt.GetTriangles().size();
+
+  p2t::CompactMesh mesh;
+  cdt.ExportMesh(mesh);
+  BOOST_REQUIRE_EQUAL(mesh.size(), num_triangles);
+  std::vector<std::uint32_t> triangles(3 * num_triangles);
+  std::vector<std::uint8_t> constrained(num_triangles);
+  cdt.ExportTriangles(triangles.data(), static_cast<std::uint32_t*>(nullptr), constrained.data());
+  BOOST_CHECK(mesh.vertices() == triangles);
+  BOOST_CHECK(mesh.constrained() == constrained);
+
+  size_t boundary_edges = 0;
+  for (std::uint32_t c = 0; c < 3 * num_triangles; ++c) {
+    const std::uint32_t o = mesh.Opposite(c);
+    BOOST_CHECK_EQUAL(mesh.IsConstrained(c), o == p2t::kNoCorner);
+    if (o == p2t::kNoCorner) {
+      ++boundary_edges;
+      continue;
+    }
+    // The opposite corner faces back, across the same edge run the other way
+    BOOST_CHECK_EQUAL(mesh.Opposite(o), c);
+    BOOST_CHECK_NE(p2t::CompactMesh::TriangleOf(o), p2t::CompactMesh::TriangleOf(c));
+    BOOST_CHECK_EQUAL(mesh.Vertex(p2t::CompactMesh::Next(c)),
+                      mesh.Vertex(p2t::CompactMesh::Prev(o)));
+    BOOST_CHECK_EQUAL(mesh.Vertex(p2t::CompactMesh::Prev(c)),
+                      mesh.Vertex(p2t::CompactMesh::Next(o)));
+  }
+  BOOST_CHECK_EQUAL(boundary_edges, polyline.size() + hole.size());
+
+  // Exporting again after a reset reuses the mesh
+  std::vector<p2t::Point> square{ { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+  cdt.Reset({ &square[0], &square[1], &square[2], &square[3] });
+  cdt.Triangulate();
+  cdt.ExportMesh(mesh);
+  BOOST_CHECK_EQUAL(mesh.size(), 2u);
+  // Only the diagonal has a triangle on both sides
+  std::vector<std::uint32_t> diagonal;
+  for (std::uint32_t c = 0; c < 6; ++c) {
+    if (mesh.Opposite(c) != p2t::kNoCorner) {
+      diagonal.push_back(c);
+    }
+  }
+  BOOST_REQUIRE_EQUAL(diagonal.size(), 2u);
+  BOOST_CHECK_EQUAL(mesh.Opposite(diagonal[0]), diagonal[1]);
+
+  for (auto points : { &polyline, &hole }) {
+    for (const auto p : *points) {
+      delete p;
+    }
+  }
+}
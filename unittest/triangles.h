@@ -0,0 +1,43 @@
+// Triangulations in a form to compare, whatever order their triangles and
+// vertices come in
+
+#pragma once
+
+#include <poly2tri/poly2tri.h>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+/// Triangles as the coordinates of their vertices, each sorted and in order
+typedef std::vector<std::array<double, 6>> Triangles;
+
+/// The triangles of points taken three at a time
+inline Triangles SortedTriangles(const std::vector<p2t::Point*>& points)
+{
+  Triangles triangles;
+  triangles.reserve(points.size() / 3);
+  for (size_t i = 0; i + 2 < points.size(); i += 3) {
+    std::array<std::pair<double, double>, 3> v;
+    for (size_t k = 0; k < 3; ++k) {
+      v[k] = { points[i + k]->x, points[i + k]->y };
+    }
+    std::sort(v.begin(), v.end());
+    triangles.push_back(
+      { v[0].first, v[0].second, v[1].first, v[1].second, v[2].first, v[2].second });
+  }
+  std::sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+
+/// The triangles of a triangulation
+inline Triangles SortedTriangles(const std::vector<p2t::Triangle*>& triangles)
+{
+  std::vector<p2t::Point*> points;
+  points.reserve(3 * triangles.size());
+  for (auto t : triangles) {
+    points.insert(points.end(), { t->GetPoint(0), t->GetPoint(1), t->GetPoint(2) });
+  }
+  return SortedTriangles(points);
+}